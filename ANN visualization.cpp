@@ -1,146 +1,243 @@
+// Compile (Linux): g++ "ANN visualization.cpp" -lGL -lGLU -lglut -lEGL -o ann
+// Headless: ./ann --headless --frames 500 [--size 1280x720] [--out frames/]
+// Network: --layers 3,4,2 (neurons per layer, input first), --simd scalar|sse|avx,
+//          --epochs-per-frame N (default 1)
+// View: --distance D (camera distance, default 15; W/S zoom), --edge-budget N (default 20000),
+//       --no-instancing (expand neuron spheres on the CPU)
+// Keys: A/D rotate, W/S zoom, P pause/resume training, H frame stats
+#define GL_GLEXT_PROTOTYPES // instanced drawing in render_batch.h
 #include <GL/freeglut.h>
 #include <cmath>
 #include <iostream>
 #include <sstream>
+#include <chrono>
+#include <vector>
+#include "headless.h"
+#include "gl_stats.h"
+#include "render_batch.h"
+#include "text_atlas.h"
+#include "ann_engine.h"
+#include "connection_lod.h"
+#include "sphere_lod.h"
+#include "frame_damage.h"
+#include "sim_clock.h"
 
 // Window size
 int winW = 1000, winH = 700;
 float angle = 0.0f;
+float cameraDistance = 15.0f;
 bool forwardPass = true;
 float animProgress = 0.0f;
+float shownProgress = 0.0f;  // pulse drawn: animProgress, or in between steps in the window
+bool shownForward = true;
 float errorValue = 0.25f;
 int epoch = 0;
+bool paused = false;  // P: training and the pulse stop, and with them the redraws
+bool idleArmed = false;
+SimClock simClock;    // training and pulse steps at 20 Hz of wall-clock time
+
+// Network being trained and the dataset it learns
+std::vector<int> layerWidths = { 3, 4, 2 }; // --layers
+AnnNetwork net;
+AnnDataset trainingSet;
+const int TRAINING_ROWS = 256, TRAINING_BATCH = 16;
+const float LEARNING_RATE = 0.5f;
+int epochsPerFrame = 1;
+long long samplesTrained = 0;
+double trainingMs = 0;
 
 // Structure for neuron position
 struct Neuron {
     float x, y, z;
 };
 
-// Layer setup
-Neuron inputLayer[3];
-Neuron hiddenLayer[4];
-Neuron outputLayer[2];
+// Layer setup: neuron positions per layer, and a sphere radius per layer
+std::vector<std::vector<Neuron>> layerNeurons;
+std::vector<float> neuronRadius;
+
+// Connection level of detail (culling, faint-edge dropping, bundling, budget)
+EdgeLodSettings edgeLod;
+EdgeLodStats edgeStats;
+std::vector<LodEdge> visibleEdges;
 
 // ==========================
 // 🧩 Draw Text Function
 // ==========================
+// Window pixel coordinates; queued and drawn with the rest of the frame's text
 void drawText(const char* text, int x, int y) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    int viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
-    gluOrtho2D(0, viewport[2], 0, viewport[3]);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-
-    glRasterPos2i(x, y);
-    for (const char* c = text; *c != '\0'; c++) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-    }
-
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
+    textDrawWindow(text, (float)x, (float)y, 0.8f, 0.2f, 0.2f); // red, as the overlay has always been
 }
 
 // ==========================
-// 🎨 Draw a neuron (sphere)
+// 🎨 Draw a layer of neurons (spheres)
 // ==========================
-void drawNeuron(Neuron n, float r, float g, float b) {
-    glPushMatrix();
-    glTranslatef(n.x, n.y, n.z);
-    glColor3f(r, g, b);
-    glutSolidSphere(0.2, 20, 20);
-    glPopMatrix();
+// One call per layer from the cached sphere meshes; the level of detail
+// follows the on-screen size of the layer's nearest neuron
+void drawNeuronLayer(const std::vector<Neuron>& neurons, float radius, const EdgeLodView& view,
+    float r, float g, float b) {
+    const float* xyz = &neurons[0].x;
+    int n = (int)neurons.size();
+    float pixels = sphereLodPixelRadius(view.mvp, view.height, xyz, n, radius);
+    sphereLodDrawLayer(xyz, n, radius, pixels, r, g, b);
 }
 
 // ==========================
 // ⚡ Draw connection lines
 // ==========================
-void drawConnection(Neuron a, Neuron b, float intensity, bool forward) {
-    glBegin(GL_LINES);
+void drawConnection(const LodEdge& e, float intensity, bool forward) {
     if (forward)
-        glColor3f(0.1f, intensity, 1.0f); // Blue glow
+        batchColor3f(0.1f, intensity, 1.0f); // Blue glow
     else
-        glColor3f(1.0f, 0.1f, intensity); // Red glow
+        batchColor3f(1.0f, 0.1f, intensity); // Red glow
 
-    glVertex3f(a.x, a.y, a.z);
-    glVertex3f(b.x, b.y, b.z);
-    glEnd();
+    batchLine3f(e.ax, e.ay, e.az, e.bx, e.by, e.bz);
 }
 
 // ==========================
 // 🧠 Setup layers position
 // ==========================
 void setupNetwork() {
-    for (int i = 0; i < 3; i++)
-        inputLayer[i] = { -4.0f, (float)(i - 1) * 1.5f, 0.0f };
+    // Layers spread from x = -4 to 4, each column centred on y = 0. Up to three
+    // neurons sit 1.5 apart; wider layers shrink to fit (4 neurons: 1.2 apart).
+    int layers = (int)layerWidths.size();
+    layerNeurons.assign(layers, std::vector<Neuron>());
+    neuronRadius.assign(layers, 0.2f);
+    for (int l = 0; l < layers; l++) {
+        int n = layerWidths[l];
+        float x = -4.0f + 8.0f * l / (layers - 1);
+        float spacing = n <= 3 ? 1.5f : 4.8f / n;
+        neuronRadius[l] = fminf(0.2f, 0.4f * spacing);
+        for (int i = 0; i < n; i++)
+            layerNeurons[l].push_back({ x, (float)(i - (n - 1) / 2.0f) * spacing, 0.0f });
+    }
 
-    for (int i = 0; i < 4; i++)
-        hiddenLayer[i] = { 0.0f, (float)(i - 1.5f) * 1.2f, 0.0f };
+    annInit(net, layerWidths, TRAINING_BATCH, 12345u);
+    annMakeDataset(trainingSet, layerWidths.front(), layerWidths.back(), TRAINING_ROWS, 777u);
+}
 
-    for (int i = 0; i < 2; i++)
-        outputLayer[i] = { 4.0f, (float)(i - 0.5f) * 1.5f, 0.0f };
+// Train for epochsPerFrame epochs on the built-in dataset
+void trainNetwork() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < epochsPerFrame; i++) {
+        errorValue = annTrainEpoch(net, trainingSet, LEARNING_RATE);
+        epoch++;
+    }
+    trainingMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    samplesTrained += (long long)epochsPerFrame * trainingSet.rows;
+}
+
+double trainingSamplesPerSec() {
+    return trainingMs > 0 ? samplesTrained * 1000.0 / trainingMs : 0.0;
 }
 
 // ==========================
 // 🌀 Animation control
 // ==========================
-void update(int value) {
+// Pulse shown `alpha` of the way from the previous step to the last one
+void showAnimation(float alpha) {
+    shownProgress = animProgress - 0.02f * (1 - alpha);
+    shownForward = forwardPass;
+    if (shownProgress < 0) { // still before the last switch of direction
+        shownProgress += 1.0f;
+        shownForward = !forwardPass;
+    }
+}
+
+void stepAnimation() {
+    trainNetwork();
     animProgress += 0.02f;
     if (animProgress >= 1.0f) {
         animProgress = 0.0f;
         forwardPass = !forwardPass; // Switch direction
-        epoch++;
-        errorValue *= 0.95f; // Gradual error reduction
     }
-    glutPostRedisplay();
-    glutTimerFunc(50, update, 0);
+    showAnimation(1);
+}
+
+// Whether the frame differs from the last one drawn
+bool frameChanged() {
+    struct { float angle, cameraDistance, progress; int forward, epoch, hud; } visible =
+        { angle, cameraDistance, shownProgress, shownForward, epoch, glStats.hud };
+    return damageCheck(&visible, sizeof(visible));
+}
+
+// Idle loop: run the steps due by the clock and draw in between the last two
+void idle() {
+    idleArmed = !paused; // no steps while paused; keyboard() restarts them
+    if (paused) {
+        glutIdleFunc(nullptr);
+        return;
+    }
+    int steps = simClockAdvance(simClock);
+    for (int i = 0; i < steps; ++i) stepAnimation();
+    showAnimation(simClockAlpha(simClock));
+    if (frameChanged()) glutPostRedisplay();
+    else simClockWait(simClock);
 }
 
 // ==========================
 // 🪄 Render Scene
 // ==========================
 void renderScene() {
+    glStatsBeginFrame();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    batchBeginFrame();
+    glStatsSceneBegin();
     glLoadIdentity();
-    gluLookAt(0, 0, 15, 0, 0, 0, 0, 1, 0);
+    gluLookAt(0, 0, cameraDistance, 0, 0, 0, 0, 1, 0);
 
     glRotatef(angle, 0.0f, 1.0f, 0.0f);
 
     // === Draw connections ===
-    float intensity = fabs(sin(animProgress * 3.14f));
-
-    // Input → Hidden
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 4; j++)
-            drawConnection(inputLayer[i], hiddenLayer[j], intensity, forwardPass);
+    // The pulse sweeps the signal along; each edge glows with its trained
+    // weight relative to the strongest weight in its layer. The edge budget is
+    // shared between layer pairs by their number of weights.
+    float intensity = fabs(sin(shownProgress * 3.14f));
 
-    // Hidden → Output
-    for (int i = 0; i < 4; i++)
-        for (int j = 0; j < 2; j++)
-            drawConnection(hiddenLayer[i], outputLayer[j], intensity, forwardPass);
+    EdgeLodView view;
+    edgeLodCaptureView(view);
+    sphereLodBeginFrame();
+    edgeStats = EdgeLodStats();
+    visibleEdges.clear();
+    long long totalWeights = 0;
+    for (const AnnLayer& L : net.layers) totalWeights += (long long)L.in * L.out;
+    for (size_t l = 0; l < net.layers.size(); l++) {
+        const AnnLayer& L = net.layers[l];
+        int budget = (int)((double)edgeLod.budget * L.in * L.out / totalWeights);
+        edgeLodBuild(view, edgeLod, budget, &layerNeurons[l][0].x, L.in, &layerNeurons[l + 1][0].x, L.out,
+            L.weights, L.stride, visibleEdges, edgeStats);
+    }
+    for (const LodEdge& e : visibleEdges)
+        drawConnection(e, intensity * e.strength, shownForward);
 
     // === Draw neurons ===
-    for (int i = 0; i < 3; i++)
-        drawNeuron(inputLayer[i], 0.2f, 0.8f, 0.2f); // Green input
-
-    for (int i = 0; i < 4; i++)
-        drawNeuron(hiddenLayer[i], 0.9f, 0.9f, 0.2f); // Yellow hidden
+    for (size_t l = 0; l < layerNeurons.size(); l++) {
+        float r = 0.9f, g = 0.9f, b = 0.2f; // Yellow hidden
+        if (l == 0) { r = 0.2f; g = 0.8f; b = 0.2f; } // Green input
+        else if (l + 1 == layerNeurons.size()) { r = 0.8f; g = 0.2f; b = 0.2f; } // Red output
+        drawNeuronLayer(layerNeurons[l], neuronRadius[l], view, r, g, b);
+    }
 
-    for (int i = 0; i < 2; i++)
-        drawNeuron(outputLayer[i], 0.8f, 0.2f, 0.2f); // Red output
+    // All connections (and CPU-expanded spheres) go out in one draw per
+    // primitive type, under the same camera transform
+    batchFlush();
 
     // === Overlay Info ===
     std::stringstream ss;
-    ss << "Epoch: " << epoch << "   Error: " << errorValue;
+    ss << "Epoch: " << epoch << "   Error: " << errorValue << "   Samples/s: " << (long long)trainingSamplesPerSec();
     std::string s = ss.str();
     drawText(s.c_str(), 10, winH - 20);
+    if (edgeStats.weights > edgeStats.drawn) {
+        std::stringstream es;
+        es << "Edges: " << edgeStats.drawn << " of " << edgeStats.weights << " drawn";
+        drawText(es.str().c_str(), 10, winH - 45);
+    }
+    glStatsSceneEnd();
+    glStatsDrawHud([](const char* s, float x, float y) { textDrawWindow(s, x, y, 1.0f, 0.6f, 0.1f); });
+    textFlush();
+    glStatsEndFrame("ann", batch.stats.primitives + batch.stats.instances);
 
-    glutSwapBuffers();
+    presentFrame();
 }
 
 // ==========================
@@ -150,6 +247,7 @@ void initGL() {
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.05f, 0.05f, 0.08f, 1.0f);
     glShadeModel(GL_SMOOTH);
+    batchInit3D();
 }
 
 // ==========================
@@ -171,13 +269,61 @@ void keyboard(unsigned char key, int x, int y) {
     if (key == 27) exit(0); // ESC
     if (key == 'a') angle -= 5;
     if (key == 'd') angle += 5;
-    glutPostRedisplay();
+    if (key == 'w') cameraDistance = fmaxf(2.0f, cameraDistance * 0.9f); // zoom in
+    if (key == 's') cameraDistance = fminf(90.0f, cameraDistance / 0.9f); // zoom out
+    if (key == 'h') glStatsToggleHud();
+    if (key == 'p') paused = !paused;
+    if (frameChanged()) glutPostRedisplay();
+    if (!paused && !idleArmed) {
+        idleArmed = true;
+        simClockReset(simClock);
+        glutIdleFunc(idle);
+    }
 }
 
 // ==========================
 // 🚀 Main Function
 // ==========================
 int main(int argc, char** argv) {
+    const char* simd = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--layers") == 0 && i + 1 < argc) {
+            if (!annParseLayers(argv[++i], layerWidths)) {
+                fprintf(stderr, "--layers expects at least two widths, e.g. 3,4,2\n");
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--simd") == 0 && i + 1 < argc) simd = argv[++i];
+        else if (strcmp(argv[i], "--epochs-per-frame") == 0 && i + 1 < argc) epochsPerFrame = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--distance") == 0 && i + 1 < argc) cameraDistance = atof(argv[++i]);
+        else if (strcmp(argv[i], "--edge-budget") == 0 && i + 1 < argc) edgeLod.budget = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--no-instancing") == 0) batch.instancing = 0;
+        else if (!glStatsParseArg(argc, argv, i)) headlessParseArg(argc, argv, i); // anything else is left to glutInit
+    }
+    if (!annSelectPath(simd)) {
+        fprintf(stderr, "Unsupported --simd path: %s\n", simd);
+        return 1;
+    }
+    if (headless.enabled) {
+        if (!headlessInitContext()) return 1;
+        initGL();
+        setupNetwork();
+        reshape(headless.width, headless.height);
+        headless.vertexCounter = &glStats.totalVertices;
+        headlessRun(stepAnimation, renderScene, frameChanged);
+        headlessWriteBench();
+        batchPrintStats();
+        printf("edges: %d of %lld weights drawn in the last frame (%d after bundling, %d culled, %d faint)\n",
+            edgeStats.drawn, edgeStats.weights, edgeStats.bundles, edgeStats.culled, edgeStats.faint);
+        const int* levels = sphereLod.drawsPerLevel;
+        printf("neurons: layers drawn at sphere LOD 20x20 %d, 12x8 %d, 8x6 %d, impostor %d (%s)\n",
+            levels[0], levels[1], levels[2], levels[3], sphereLodInstancing() ? "instanced" : "CPU-expanded");
+        printf("training: %lld samples in %.1f ms (%.0f samples/sec, %s kernels), final error %g\n",
+            samplesTrained, trainingMs, trainingSamplesPerSec(), annPath.name, errorValue);
+        damagePrintStats();
+        return 0;
+    }
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(winW, winH);
@@ -189,7 +335,9 @@ int main(int argc, char** argv) {
     glutDisplayFunc(renderScene);
     glutReshapeFunc(reshape);
     glutKeyboardFunc(keyboard);
-    glutTimerFunc(50, update, 0);
+    simClockInit(simClock, 20);
+    idleArmed = true;
+    glutIdleFunc(idle);
 
     glutMainLoop();
     return 0;
@@ -1,158 +1,217 @@
+// Compile (Linux): g++ "Dengue Awareness.cpp" -lGL -lGLU -lglut -lEGL -o dengue
+// Headless: ./dengue --headless --frames 2000 [--size 1280x720] [--out frames/]
+// Swarm: --mosquitoes N (default 15), --simd scalar|sse|avx (default: best available),
+//        --no-instancing (expand the mosquito template on the CPU),
+//        --threads N (simulation threads, default: all cores), --sim-hz R (default 20)
+// Sprays: press S for each new spray; --spray-every N starts one every N steps
+// Redraws: --skip-unchanged (headless) leaves out frames nothing moved in
+#define GL_GLEXT_PROTOTYPES // instanced drawing in render_batch.h
 #include <GL/glut.h>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <cstring>
 #include <cstdio>
-
-// Structure to represent a mosquito
-struct Mosquito {
-    float x, y;       // Position
-    float dx, dy;     // Direction of movement7
-    float size;       // Size of the mosquito
-};
-
-const int NUM_MOSQUITOES = 15; // Number of mosquitoes
-Mosquito mosquitoes[NUM_MOSQUITOES];
+#include "headless.h"
+#include "gl_stats.h"
+#include "circle_cache.h"
+#include "render_batch.h"
+#include "text_atlas.h"
+#include "layer_cache.h"
+#include "frame_damage.h"
+#include "mosquito_swarm.h"
+#include "spatial_grid.h"
+#include "soft_raster.h"
+#include <mutex>
+#include <vector>
+
+// Mosquitoes live in structure-of-arrays form (x[], y[], dx[], dy[], size[])
+int numMosquitoes = 15; // Number of mosquitoes (--mosquitoes N)
+int simThreads = 0;      // 0: one per hardware thread
+double simHz = 20.0;     // fixed simulation rate (the old 50 ms timer)
+SwarmScheduler swarmSim; // double-buffered swarm state, stepped off the render thread
+BatchMesh mosquitoMesh; // drawMosquito() recorded once at unit size
+LayerCache sceneryLayer; // sky, clouds, houses, trees and pond
 
 // Variables for pond, water bowl, and spray
 bool waterBowlVisible = false;
-bool spraying = false;
-float sprayX = 0.0f, sprayY = 0.0f, sprayRadius = 0.02f;
 float waterBowlX = -0.4f, waterBowlY = -0.9f, waterBowlRadius = 0.05f;
+float pondX = 0.7f, pondY = -0.85f, pondRadiusX = 0.3f, pondRadiusY = 0.2f;
+const float WATER_RANGE = 0.1f; // "near the water" margin around the bowl and pond
+
+// Sprays are simulation state: they grow and kill on the swarm thread each
+// step, and keyboard() / display() touch them under sprayMutex
+struct Spray {
+    float x, y, radius;
+};
+std::vector<Spray> sprays;
+std::mutex sprayMutex;
+int sprayEvery = 0;          // headless: start a spray every N steps (--spray-every N)
+int mosquitoesKilled = 0, nearBowl = 0, nearPond = 0;
+bool timerArmed = false;     // the timer and the swarm thread only run while something moves
+
+// Spatial index over the swarm, kept up to date on the swarm thread
+SpatialGrid mosquitoGrid;
+const int GRID_CELLS = 32;   // 0.0625 world units per cell, under a full-grown spray's radius
+std::vector<int> pendingKills; // killed last step; still sized in the other buffer
+std::vector<int> queryHits;
+
+// Start a spray at a random spot (S key)
+void startSpray() {
+    Spray s;
+    s.x = (rand() % 200 - 100) / 100.0f;
+    s.y = (rand() % 200 - 100) / 100.0f;
+    s.radius = 0.02f;
+    std::lock_guard<std::mutex> lock(sprayMutex);
+    sprays.push_back(s);
+}
+
+// Swarm-thread hook run on every new state: re-bucket moved mosquitoes, let each
+// spray kill what it covers and grow, and count mosquitoes near standing water.
+// Every query only visits the grid cells under its shape.
+void stepSprays(MosquitoSwarm& next) {
+    for (int i : pendingKills) next.size[i] = 0.0f; // size isn't carried between buffers
+    pendingKills.clear();
+    gridUpdate(mosquitoGrid, next.x, next.y);
+
+    std::lock_guard<std::mutex> lock(sprayMutex);
+    for (int s = 0; s < (int)sprays.size(); ++s) {
+        queryHits.clear();
+        gridQueryCircle(mosquitoGrid, next.x, next.y, sprays[s].x, sprays[s].y, sprays[s].radius, queryHits);
+        for (int i : queryHits) {
+            // a dead mosquito stops, vanishes and leaves the index
+            next.dx[i] = next.dy[i] = next.size[i] = 0.0f;
+            gridRemove(mosquitoGrid, i);
+            pendingKills.push_back(i);
+        }
+        mosquitoesKilled += (int)queryHits.size();
+        sprays[s].radius += 0.01f;
+        if (sprays[s].radius > 0.1f) {
+            sprays.erase(sprays.begin() + s);
+            s--;
+        }
+    }
+
+    queryHits.clear();
+    if (!waterBowlVisible) {
+        float r = waterBowlRadius + WATER_RANGE;
+        gridQueryCircle(mosquitoGrid, next.x, next.y, waterBowlX, waterBowlY, r, queryHits);
+    }
+    nearBowl = (int)queryHits.size();
+    queryHits.clear();
+    gridQueryEllipse(mosquitoGrid, next.x, next.y, pondX, pondY, pondRadiusX + WATER_RANGE, pondRadiusY + WATER_RANGE, queryHits);
+    nearPond = (int)queryHits.size();
+}
 
 // Function to initialize mosquitoes with random positions and directions
 void initializeMosquitoes() {
-    srand(static_cast<unsigned>(time(0)));
-    for (int i = 0; i < NUM_MOSQUITOES; i++) {
-        mosquitoes[i].x = ((rand() % 200) / 100.0f) - 1.0f; // Random x position (-1 to 1)
-        mosquitoes[i].y = ((rand() % 200) / 100.0f) - 1.0f; // Random y position (-1 to 1)
-        mosquitoes[i].dx = ((rand() % 50) / 10000.0f) - 0.005f; // Slow random x direction
-        mosquitoes[i].dy = ((rand() % 50) / 10000.0f) - 0.005f; // Slow random y direction
-        mosquitoes[i].size = 0.05f; // Fixed small size
-    }
+    srand(headless.enabled ? 1u : static_cast<unsigned>(time(0))); // fixed seed keeps headless runs reproducible
+    MosquitoSwarm swarm;
+    swarmInit(swarm, numMosquitoes); // random positions in (-1, 1), slow random directions, fixed small size
+    gridBuild(mosquitoGrid, GRID_CELLS, swarm.x, swarm.y, swarm.count);
+    swarmSchedInit(swarmSim, swarm, simThreads > 0 ? simThreads : hardwareThreads(), simHz);
+    swarmSim.onStep = stepSprays;
 }
 
-// Function to draw a small mosquito
+// Function to draw a small mosquito (facing left); recorded once as the
+// template that every mosquito instance is drawn from
 void drawMosquito(float x, float y, float size) {
     // Body
-    glColor3f(0.0f, 0.0f, 0.0f); // Black
-    glBegin(GL_LINES);
-    glVertex2f(x - size / 2, y);
-    glVertex2f(x + size / 2, y); // Body line
-    glEnd();
+    batchColor3f(0.0f, 0.0f, 0.0f); // Black
+    batchBegin(GL_LINES);
+    batchVertex2f(x - size / 2, y);
+    batchVertex2f(x + size / 2, y); // Body line
+    batchEnd();
 
     // Head
-    glColor3f(0.2f, 0.2f, 0.2f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(x - size / 2 - size / 4, y);
-    for (int i = 0; i <= 360; i++) {
-        float angle = i * (3.14159f / 180.0f);
-        glVertex2f(x - size / 2 - size / 4 + (size / 4) * cos(angle),
-            y + (size / 4) * sin(angle));
-    }
-    glEnd();
+    batchColor3f(0.2f, 0.2f, 0.2f);
+    drawEllipse(GL_TRIANGLE_FAN, x - size / 2 - size / 4, y, size / 4, size / 4, 16); // a few pixels across
 
     // Wings
-    glColor3f(0.5f, 0.5f, 0.5f);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(x, y);
-    glVertex2f(x - size * 1.5f, y + size);
-    glVertex2f(x - size / 2, y); // Left wing
-    glEnd();
-
-    glBegin(GL_TRIANGLES);
-    glVertex2f(x, y);
-    glVertex2f(x + size * 1.5f, y + size);
-    glVertex2f(x + size / 2, y); // Right wing
-    glEnd();
+    batchColor3f(0.5f, 0.5f, 0.5f);
+    batchBegin(GL_TRIANGLES);
+    batchVertex2f(x, y);
+    batchVertex2f(x - size * 1.5f, y + size);
+    batchVertex2f(x - size / 2, y); // Left wing
+    batchEnd();
+
+    batchBegin(GL_TRIANGLES);
+    batchVertex2f(x, y);
+    batchVertex2f(x + size * 1.5f, y + size);
+    batchVertex2f(x + size / 2, y); // Right wing
+    batchEnd();
 
     // Proboscis
-    glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_LINES);
-    glVertex2f(x - size / 2 - size / 4, y);
-    glVertex2f(x - size / 2 - size / 2, y); // Proboscis
-    glEnd();
+    batchColor3f(0.0f, 0.0f, 0.0f);
+    batchBegin(GL_LINES);
+    batchVertex2f(x - size / 2 - size / 4, y);
+    batchVertex2f(x - size / 2 - size / 2, y); // Proboscis
+    batchEnd();
 }
 
 // Function to draw a house
 void drawHouse(float x, float y, float width, float height) {
     // Base of the house
-    glColor3f(0.55f, 0.27f, 0.07f); // Dark brown
-    glBegin(GL_QUADS);
-    glVertex2f(x, y);
-    glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height);
-    glVertex2f(x, y + height);
-    glEnd();
+    batchColor3f(0.55f, 0.27f, 0.07f); // Dark brown
+    batchBegin(GL_QUADS);
+    batchVertex2f(x, y);
+    batchVertex2f(x + width, y);
+    batchVertex2f(x + width, y + height);
+    batchVertex2f(x, y + height);
+    batchEnd();
 
     // Roof of the house
-    glColor3f(0.0f, 0.0f, 0.5f); // Dark blue
-    glBegin(GL_TRIANGLES);
-    glVertex2f(x, y + height);
-    glVertex2f(x + width / 2, y + height + height / 2);
-    glVertex2f(x + width, y + height);
-    glEnd();
+    batchColor3f(0.0f, 0.0f, 0.5f); // Dark blue
+    batchBegin(GL_TRIANGLES);
+    batchVertex2f(x, y + height);
+    batchVertex2f(x + width / 2, y + height + height / 2);
+    batchVertex2f(x + width, y + height);
+    batchEnd();
 }
 
 // Function to draw a tree
 void drawTree(float x, float y) {
     // Tree trunk
-    glColor3f(0.54f, 0.27f, 0.07f); // Brown
-    glBegin(GL_QUADS);
-    glVertex2f(x, y);
-    glVertex2f(x + 0.05f, y);
-    glVertex2f(x + 0.05f, y + 0.3f);
-    glVertex2f(x, y + 0.3f);
-    glEnd();
+    batchColor3f(0.54f, 0.27f, 0.07f); // Brown
+    batchBegin(GL_QUADS);
+    batchVertex2f(x, y);
+    batchVertex2f(x + 0.05f, y);
+    batchVertex2f(x + 0.05f, y + 0.3f);
+    batchVertex2f(x, y + 0.3f);
+    batchEnd();
 
     // Tree leaves
-    glColor3f(0.0f, 0.5f, 0.0f); // Green
-    glBegin(GL_TRIANGLES);
-    glVertex2f(x - 0.1f, y + 0.3f);
-    glVertex2f(x + 0.15f, y + 0.5f);
-    glVertex2f(x + 0.3f, y + 0.3f); // Top triangle
-    glEnd();
-
-    glBegin(GL_TRIANGLES);
-    glVertex2f(x - 0.1f, y + 0.45f);
-    glVertex2f(x + 0.15f, y + 0.7f);
-    glVertex2f(x + 0.3f, y + 0.45f); // Bottom triangle
-    glEnd();
+    batchColor3f(0.0f, 0.5f, 0.0f); // Green
+    batchBegin(GL_TRIANGLES);
+    batchVertex2f(x - 0.1f, y + 0.3f);
+    batchVertex2f(x + 0.15f, y + 0.5f);
+    batchVertex2f(x + 0.3f, y + 0.3f); // Top triangle
+    batchEnd();
+
+    batchBegin(GL_TRIANGLES);
+    batchVertex2f(x - 0.1f, y + 0.45f);
+    batchVertex2f(x + 0.15f, y + 0.7f);
+    batchVertex2f(x + 0.3f, y + 0.45f); // Bottom triangle
+    batchEnd();
 }
 
 // Function to draw a pond
 void drawPond() {
-    glColor3f(0.0f, 0.0f, 1.0f); // Blue color for water
-    glBegin(GL_POLYGON);
-    for (int i = 0; i < 360; i++) {
-        float angle = i * 3.14159f / 180.0f;
-        glVertex2f(0.7f + 0.3f * cos(angle), -0.85f + 0.2f * sin(angle)); // Pond shape
-    }
-    glEnd();
+    batchColor3f(0.0f, 0.0f, 1.0f); // Blue color for water
+    drawEllipse(GL_POLYGON, pondX, pondY, pondRadiusX, pondRadiusY, 360); // Pond shape
 }
 
-// Function to update mosquito positions
+// Function to update mosquito positions (direction reverses at the boundary).
+// Windowed runs call this from the scheduler thread at simHz; headless runs
+// call it once per frame.
 void updateMosquitoes() {
-    for (int i = 0; i < NUM_MOSQUITOES; i++) {
-        mosquitoes[i].x += mosquitoes[i].dx;
-        mosquitoes[i].y += mosquitoes[i].dy;
-
-        // Reverse direction if mosquito hits a boundary
-        if (mosquitoes[i].x < -1.0f || mosquitoes[i].x > 1.0f)
-            mosquitoes[i].dx = -mosquitoes[i].dx;
-        if (mosquitoes[i].y < -1.0f || mosquitoes[i].y > 1.0f)
-            mosquitoes[i].dy = -mosquitoes[i].dy;
-    }
+    if (sprayEvery > 0 && swarmSim.steps % sprayEvery == 0) startSpray();
+    swarmSchedStep(swarmSim);
 }
 
 // Function to display text on the screen
 void displayText(const char* text, float x, float y) {
-    glColor3f(0.0f, 0.0f, 0.0f); // Black text
-    glRasterPos2f(x, y);
-    for (int i = 0; i < strlen(text); i++) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, text[i]);
-    }
+    textDraw(text, x, y, batchNextLayerZ(), 0.0f, 0.0f, 0.0f); // Black text, in painter's order with batched shapes
 }
 
 // // Function to draw a bowl with water inside
@@ -183,6 +242,7 @@ void displayInstructions() {
         "Please Press :",
         " S: Start Spray Effect",
         " R: Remove Water from the Bowl",
+        " H: Show Frame Stats",
         "",
         "Instructions:",
         "1. Keep water clean,",
@@ -192,7 +252,7 @@ void displayInstructions() {
     };
 
     float yPos = 0.9f;
-    for (int i = 0; i < 8; i++) {
+    for (int i = 0; i < 9; i++) {
         displayText(instructions[i], 0.3f, yPos);
         yPos -= 0.05f;  // Move to the next line
     }
@@ -200,108 +260,143 @@ void displayInstructions() {
 
 // Function to draw clouds in the sky
 void drawCloud(float x, float y) {
-    glColor3f(1.0f, 1.0f, 1.0f); // White
-    glBegin(GL_POLYGON);
-    for (int i = 0; i < 360; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
-        glVertex2f(x + 0.1f * cos(angle), y + 0.1f * sin(angle));
-    }
-    glEnd();
+    batchColor3f(1.0f, 1.0f, 1.0f); // White
+    drawEllipse(GL_POLYGON, x, y, 0.1f, 0.1f, 36);
 }
 // Display function
 void display() {
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    // Draw background
-    glColor3f(0.53f, 0.81f, 0.92f); // Sky blue
-    glBegin(GL_QUADS);
-    glVertex2f(-1.0f, -1.0f);
-    glVertex2f(1.0f, -1.0f);
-    glVertex2f(1.0f, 1.0f);
-    glVertex2f(-1.0f, 1.0f);
-    glEnd();
-
-    // Draw clouds
-    drawCloud(-0.8f, 0.6f);
-    drawCloud(0.2f, 0.8f);
-    drawCloud(0.6f, 0.5f);
-
-    // Draw houses
-    drawHouse(-0.9f, -0.8f, 0.3f, 0.3f); // House 1
-    drawHouse(-0.5f, -0.8f, 0.4f, 0.4f); // House 2
-    drawHouse(0.0f, -0.8f, 0.25f, 0.25f); // House 3
-
-    // Draw trees
-    drawTree(-0.9f, -0.5f);
-    drawTree(-0.6f, -0.6f);
-
-    drawTree(0.8f, -0.7f);
-
-    // Draw pond
-    drawPond();
-
-    // Draw mosquitoes
-    for (int i = 0; i < NUM_MOSQUITOES; i++) {
-        drawMosquito(mosquitoes[i].x, mosquitoes[i].y, mosquitoes[i].size);
+    glStatsBeginFrame();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    batchBeginFrame();
+    glStatsSceneBegin();
+    const MosquitoSwarm& swarm = swarmSchedAcquire(swarmSim); // latest finished step
+
+    // Static scenery: drawn once, then composited from the layer cache
+    if (layerCacheBegin(sceneryLayer, 0)) {
+        // Draw background
+        batchColor3f(0.53f, 0.81f, 0.92f); // Sky blue
+        batchBegin(GL_QUADS);
+        batchVertex2f(-1.0f, -1.0f);
+        batchVertex2f(1.0f, -1.0f);
+        batchVertex2f(1.0f, 1.0f);
+        batchVertex2f(-1.0f, 1.0f);
+        batchEnd();
+
+        // Draw clouds
+        drawCloud(-0.8f, 0.6f);
+        drawCloud(0.2f, 0.8f);
+        drawCloud(0.6f, 0.5f);
+
+        // Draw houses
+        drawHouse(-0.9f, -0.8f, 0.3f, 0.3f); // House 1
+        drawHouse(-0.5f, -0.8f, 0.4f, 0.4f); // House 2
+        drawHouse(0.0f, -0.8f, 0.25f, 0.25f); // House 3
+
+        // Draw trees
+        drawTree(-0.9f, -0.5f);
+        drawTree(-0.6f, -0.6f);
+
+        drawTree(0.8f, -0.7f);
+
+        // Draw pond
+        drawPond();
+        layerCacheEnd(sceneryLayer);
     }
 
+    // Draw mosquitoes: one instanced draw of the template, each facing its
+    // direction of flight (the template's head is at -x, hence dirSign -1)
+    batchDrawInstances(mosquitoMesh, swarm.x, swarm.y, swarm.size, swarm.dx, swarm.dy, swarm.count, -1.0f, true);
+
     // Draw water bowl if visible
     if (!waterBowlVisible) {
-        glColor3f(0.0f, 0.0f, 1.0f);  // Blue water bowl
-        glBegin(GL_POLYGON);
-        for (int i = 0; i < 360; i++) {
-            float angle = i * 3.14159f / 180.0f;
-            glVertex2f(waterBowlX + waterBowlRadius * cos(angle), waterBowlY + waterBowlRadius * sin(angle));
-        }
-        glEnd();
+        batchColor3f(0.0f, 0.0f, 1.0f);  // Blue water bowl
+        drawEllipse(GL_POLYGON, waterBowlX, waterBowlY, waterBowlRadius, waterBowlRadius, 360);
     }
 
-    // Draw spray effect if active
-    if (spraying) {
-        glColor3f(0.1f, 0.5f, 1.0f);  // Light blue spray
-        glBegin(GL_TRIANGLE_FAN);
-        glVertex2f(sprayX, sprayY);
-        for (int i = 0; i <= 360; i++) {
-            float angle = i * 3.14159f / 180.0f;
-            glVertex2f(sprayX + sprayRadius * cos(angle), sprayY + sprayRadius * sin(angle));
-        }
-        glEnd();
-        sprayRadius += 0.01f;
-        if (sprayRadius > 0.1f) {
-            spraying = false;
-        }
+    // Draw spray effects (they grow on the swarm thread)
+    char status[96];
+    {
+        std::lock_guard<std::mutex> lock(sprayMutex);
+        batchColor3f(0.1f, 0.5f, 1.0f);  // Light blue spray
+        for (const Spray& s : sprays)
+            drawEllipse(GL_TRIANGLE_FAN, s.x, s.y, s.radius, s.radius, 360);
+        snprintf(status, sizeof(status), "Sprayed: %d  Near water: bowl %d, pond %d",
+            mosquitoesKilled, nearBowl, nearPond);
     }
 
     // Display text
     displayText("Dengue Awareness: Mosquitoes", -0.9f, 0.9f);
+    displayText(status, -0.9f, 0.85f);
 
     // Display instructions
     displayInstructions();
+    glStatsSceneEnd();
+    glStatsDrawHud([](const char* s, float x, float y) { textQueue(s, x, y, batchNextLayerZ(), 0.9f, 0.4f, 0.0f); });
+
+    batchFlush();
+    textFlush();
+    swarmSchedRelease(swarmSim);
+    glStatsEndFrame("dengue", batch.stats.primitives + batch.stats.instances);
+    presentFrame();
+}
+
+// Whether a new simulation state moves anything: a mosquito is alive or a
+// spray is growing (call under sprayMutex)
+bool swarmMoving() {
+    return mosquitoesKilled < numMosquitoes || !sprays.empty();
+}
 
-    glutSwapBuffers();
+// Whether the frame differs from the last one drawn
+bool frameChanged() {
+    std::lock_guard<std::mutex> lock(sprayMutex);
+    long long state = swarmMoving() ? swarmSchedPublished(swarmSim) : -1;
+    long long visible[] = { state, waterBowlVisible, mosquitoesKilled, nearBowl, nearPond, glStats.hud };
+    return damageCheck(visible, sizeof(visible));
 }
 
-// Timer function for animation
+// Timer function for animation; once nothing moves, the swarm thread is
+// paused and the timer left unarmed until keyboard() starts something
 void timer(int value) {
-    updateMosquitoes();      // Update positions
-    glutPostRedisplay();     // Redraw the scene
-    glutTimerFunc(50, timer, 0); // Approx 20 FPS
+    if (frameChanged()) glutPostRedisplay(); // positions are updated by swarmSim
+    bool moving;
+    {
+        std::lock_guard<std::mutex> lock(sprayMutex);
+        moving = swarmMoving();
+    }
+    if (moving) glutTimerFunc(50, timer, 0); // Approx 20 FPS
+    else {
+        swarmSchedPause(swarmSim);
+        timerArmed = false;
+    }
+}
+
+// Restart the timer and the swarm thread when something moves again
+void armTimer() {
+    {
+        std::lock_guard<std::mutex> lock(sprayMutex);
+        if (timerArmed || !swarmMoving()) return;
+    }
+    timerArmed = true;
+    swarmSchedResume(swarmSim);
+    glutTimerFunc(50, timer, 0);
 }
 
 // Keyboard function7
 void keyboard(unsigned char key, int x, int y) {
     if (key == 's' || key == 'S') {
-        // Start spraying
-        sprayX = (rand() % 200 - 100) / 100.0f;
-        sprayY = (rand() % 200 - 100) / 100.0f;
-        sprayRadius = 0.02f;
-        spraying = true;
+        // Start spraying (any number of sprays can be active)
+        startSpray();
     }
 
     if (key == 'r' || key == 'R') {
         // Remove water bowl
+        std::lock_guard<std::mutex> lock(sprayMutex);
         waterBowlVisible = true;
     }
+
+    if (key == 'h' || key == 'H') glStatsToggleHud();
+    if (frameChanged()) glutPostRedisplay();
+    armTimer();
 }
 
 // Initialization
@@ -310,21 +405,59 @@ void init() {
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
     gluOrtho2D(-1.0, 1.0, -1.0, 1.0); // 2D orthographic projection
+    batchInit2D();
     initializeMosquitoes();
+
+    batchMeshBegin(mosquitoMesh);
+    drawMosquito(0.0f, 0.0f, 1.0f);
+    batchMeshEnd(mosquitoMesh);
 }
 
 // Main function
 int main(int argc, char** argv) {
+    const char* simd = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--mosquitoes") == 0 && i + 1 < argc) numMosquitoes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--simd") == 0 && i + 1 < argc) simd = argv[++i];
+        else if (strcmp(argv[i], "--no-instancing") == 0) batch.instancing = 0;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) simThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sim-hz") == 0 && i + 1 < argc) simHz = atof(argv[++i]);
+        else if (strcmp(argv[i], "--spray-every") == 0 && i + 1 < argc) sprayEvery = atoi(argv[++i]);
+        else if (!glStatsParseArg(argc, argv, i) && !softRasterParseArg(argc, argv, i)) headlessParseArg(argc, argv, i); // anything else is left to glutInit
+    }
+    if (!swarmSelectPath(simd)) {
+        fprintf(stderr, "Unsupported --simd path: %s\n", simd);
+        return 1;
+    }
+    printf("Swarm: %d mosquitoes, %s update\n", numMosquitoes, swarmPath.name);
+    if (headless.enabled) {
+        if (softRaster.enabled) softRasterInit(headless.width, headless.height);
+        if (!headlessInitContext()) return 1;
+        init();
+        headless.vertexCounter = &glStats.totalVertices;
+        headlessRun(updateMosquitoes, display, frameChanged);
+        headlessWriteBench();
+        batchPrintStats();
+        layerCachePrintStats("scenery", sceneryLayer);
+        damagePrintStats();
+        swarmSchedPrintStats(swarmSim);
+        softRasterPrintStats();
+        return 0;
+    }
+
     glutInit(&argc, argv);
-    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(800, 600);
     glutCreateWindow("Slowly Moving Dengue Mosquitoes with Background, Houses, Trees, Pond, Water Bowl, and Text");
 
     init();
 
     glutDisplayFunc(display);
-    glutTimerFunc(50, timer, 0); // Start timer with 50ms interval
     glutKeyboardFunc(keyboard);
+    swarmSchedStart(swarmSim);
+    armTimer(); // Start timer with 50ms interval
+    if (!timerArmed) swarmSchedPause(swarmSim); // no mosquitoes to move
+    atexit([] { swarmSchedStop(swarmSim); }); // GLUT exits from inside glutMainLoop
 
     glutMainLoop();
     return 0;
@@ -1,159 +1,250 @@
+// Compile (Linux): g++ "People Fighting(Story Base).cpp" -lGL -lGLU -lglut -lEGL -o fighting
+// Headless: ./fighting --headless --frames 600 [--size 1280x720] [--out frames/] [--skip-unchanged]
+//           [--start TICK] [--crowd N] [--battle N]
+// Keys: f jump to the fight, [ / ] scrub one second back / forward, h stats
+#define GL_GLEXT_PROTOTYPES // instanced drawing in render_batch.h
 #include <GL/glut.h>
 #include <cmath>
 #include <cstring>
+#include <vector>
+#include "headless.h"
+#include "gl_stats.h"
+#include "circle_cache.h"
+#include "render_batch.h"
+#include "text_atlas.h"
+#include "layer_cache.h"
+#include "frame_damage.h"
+#include "keyframe_timeline.h"
+#include "sim_clock.h"
+#include "crowd.h"
+#include "fighters.h"
+#include "soft_raster.h"
 
 // ---------------- Variables ----------------
-float man1X = -0.6f, man1Y = -0.3f;
-float man2X = 0.6f, man2Y = -0.3f;
-bool fighting = false;
-bool collided = false;
+const float MAN1_START_X = -0.6f, MAN2_START_X = 0.6f, MAN_Y = -0.3f;
+Fighters fighters;          // the two men, or a battle's fighters
+int battleSize = 0;         // --battle N: N fighters instead of the story
 int dialogueStep = 0;
 int timerCount = 0;
+LayerCache backgroundLayer; // sky and ground never move
+Crowd crowd;                // cheers once the fight starts
+float crowdTick = -1;       // tick the crowd is posed for while it moves
+
+// ---------------- Timeline ----------------
+// The whole story is keyframed, so any tick is evaluated directly
+enum { MAN1_X, MAN2_X, DIALOGUE, FIGHT_TRACKS };
+const int FIGHT_START = 200;    // the men start walking at each other
+const int SCRUB_TICKS = 20;     // '[' / ']' jump one second
+int contactTick = 0;            // the men meet and the fight starts
+Timeline fightTimeline;
+SimClock simClock;              // story ticks at 20 Hz of wall-clock time
 
 // ---------------- Text Display ----------------
 void displayText(const char* text, float x, float y) {
-    glColor3f(0, 0, 0);
-    glRasterPos2f(x, y);
-    for (int i = 0; i < strlen(text); i++)
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, text[i]);
+    textDraw(text, x, y, batchNextLayerZ(), 0, 0, 0); // layer z keeps text in painter's order with batched shapes
 }
 
 // ---------------- Stickman ----------------
 void drawMan(float x, float y, float r, float g, float b) {
     // Head
-    glColor3f(1.0f, 0.8f, 0.6f);
-    glBegin(GL_POLYGON);
-    for (int i = 0; i < 360; i++) {
-        float angle = i * 3.1416f / 180.0f;
-        glVertex2f(x + 0.05f * cos(angle), y + 0.05f * sin(angle));
-    }
-    glEnd();
+    batchColor3f(1.0f, 0.8f, 0.6f);
+    drawEllipse(GL_POLYGON, x, y, 0.05f, 0.05f, 360);
 
     // Body
-    glColor3f(r, g, b);
-    glBegin(GL_LINES);
-    glVertex2f(x, y - 0.05f);
-    glVertex2f(x, y - 0.25f);
-    glEnd();
+    batchColor3f(r, g, b);
+    batchBegin(GL_LINES);
+    batchVertex2f(x, y - 0.05f);
+    batchVertex2f(x, y - 0.25f);
+    batchEnd();
 
     // Arms
-    glBegin(GL_LINES);
-    glVertex2f(x, y - 0.1f);
-    glVertex2f(x - 0.1f, y - 0.15f);
-    glVertex2f(x, y - 0.1f);
-    glVertex2f(x + 0.1f, y - 0.15f);
-    glEnd();
+    batchBegin(GL_LINES);
+    batchVertex2f(x, y - 0.1f);
+    batchVertex2f(x - 0.1f, y - 0.15f);
+    batchVertex2f(x, y - 0.1f);
+    batchVertex2f(x + 0.1f, y - 0.15f);
+    batchEnd();
 
     // Legs
-    glBegin(GL_LINES);
-    glVertex2f(x, y - 0.25f);
-    glVertex2f(x - 0.08f, y - 0.35f);
-    glVertex2f(x, y - 0.25f);
-    glVertex2f(x + 0.08f, y - 0.35f);
-    glEnd();
-}
-
-// ---------------- Crowd ----------------
-void drawCrowd() {
-    glColor3f(0.2f, 0.2f, 0.2f);
-    for (float i = -0.9f; i <= 0.9f; i += 0.1f) {
-        glBegin(GL_POLYGON);
-        for (int j = 0; j < 360; j++) {
-            float angle = j * 3.1416f / 180.0f;
-            glVertex2f(i + 0.02f * cos(angle), -0.1f + 0.02f * sin(angle));
-        }
-        glEnd();
-    }
+    batchBegin(GL_LINES);
+    batchVertex2f(x, y - 0.25f);
+    batchVertex2f(x - 0.08f, y - 0.35f);
+    batchVertex2f(x, y - 0.25f);
+    batchVertex2f(x + 0.08f, y - 0.35f);
+    batchEnd();
 }
 
 // ---------------- Background ----------------
 void drawBackground() {
     // Sky
-    glColor3f(0.53f, 0.81f, 0.92f);
-    glBegin(GL_QUADS);
-    glVertex2f(-1, 0);
-    glVertex2f(1, 0);
-    glVertex2f(1, 1);
-    glVertex2f(-1, 1);
-    glEnd();
+    batchColor3f(0.53f, 0.81f, 0.92f);
+    batchBegin(GL_QUADS);
+    batchVertex2f(-1, 0);
+    batchVertex2f(1, 0);
+    batchVertex2f(1, 1);
+    batchVertex2f(-1, 1);
+    batchEnd();
 
     // Ground
-    glColor3f(0.4f, 0.8f, 0.4f);
-    glBegin(GL_QUADS);
-    glVertex2f(-1, -1);
-    glVertex2f(1, -1);
-    glVertex2f(1, 0);
-    glVertex2f(-1, 0);
-    glEnd();
+    batchColor3f(0.4f, 0.8f, 0.4f);
+    batchBegin(GL_QUADS);
+    batchVertex2f(-1, -1);
+    batchVertex2f(1, -1);
+    batchVertex2f(1, 0);
+    batchVertex2f(-1, 0);
+    batchEnd();
 }
 
 // ---------------- Fighting Animation ----------------
-void updateFight() {
-    if (fighting && !collided) {
-        man1X += 0.01f;
-        man2X -= 0.01f;
-
-        if (fabs(man1X - man2X) < 0.15f) {
-            collided = true;
-            fighting = false;
-            dialogueStep = 2; // Move to next dialogue
-        }
-    }
+// Keys for the fight: the men walk 0.01 per tick towards each other until they
+// are less than 0.15 apart, then sway by 0.005 * sin(0.2 * tick) per tick. The
+// sum of that sway is a cosine, -A cos(0.2 (tick + 0.5)) around a centre, so
+// from its first turning point on it is keyed on the turning points with
+// smooth keys and looped.
+void buildFightTimeline() {
+    float x1 = MAN1_START_X, x2 = MAN2_START_X;
+    int contact = FIGHT_START - 1; // the first step is taken on FIGHT_START
+    do {
+        contact++;
+        x1 += 0.01f;
+        x2 -= 0.01f;
+    } while (fabs(x1 - x2) >= 0.15f);
 
-    if (collided) {
-        // Simple fighting movement
-        man1X += 0.005f * sin(timerCount * 0.2f);
-        man2X -= 0.005f * sin(timerCount * 0.2f);
+    const float rate = 0.2f;
+    const float amplitude = 0.005f / (2 * sinf(rate / 2));
+    float centre = x1 + amplitude * cosf(rate * (contact - 0.5f));
+    float halfPeriod = 3.14159265f / rate;
+    int turn = (int)ceilf((contact + 0.5f) / halfPeriod); // first turning point after contact
+    float firstTurn = turn * halfPeriod - 0.5f;
+    struct Key { float time, value; KeyInterp interp; };
+    std::vector<Key> man1Keys = {
+        { FIGHT_START - 1.0f, MAN1_START_X, KEY_LINEAR },
+        { contact - 1.0f, x1 - 0.01f, KEY_LINEAR },
+    };
+    // up to the first turning point the sway starts part-way through its
+    // cosine, so it gets a key per tick
+    for (int t = contact; t < firstTurn; ++t)
+        man1Keys.push_back({ (float)t, centre - amplitude * cosf(rate * (t + 0.5f)), KEY_LINEAR });
+    float sign = turn % 2 ? -1.0f : 1.0f;
+    for (int j = 0; j <= 2; ++j, sign = -sign)
+        man1Keys.push_back({ firstTurn + j * halfPeriod, centre - amplitude * sign, KEY_SMOOTH });
+
+    // Man 2 mirrors man 1
+    timelineAddTrack(fightTimeline, firstTurn);
+    for (const Key& k : man1Keys) timelineKey(fightTimeline, k.time, k.value, k.interp);
+    timelineAddTrack(fightTimeline, firstTurn);
+    for (const Key& k : man1Keys) timelineKey(fightTimeline, k.time, -k.value, k.interp);
+
+    timelineAddTrack(fightTimeline);
+    timelineKey(fightTimeline, 0, 0, KEY_STEP);
+    timelineKey(fightTimeline, 100, 1, KEY_STEP);
+    timelineKey(fightTimeline, contact, 2, KEY_STEP); // They start fighting!
+    contactTick = contact;
+    timelineKey(fightTimeline, 400, 3, KEY_STEP);
+}
+
+// Set the story state of a (possibly fractional) tick from the timeline
+void applyTimeline(float tick) {
+    float v[FIGHT_TRACKS];
+    timelineEvaluate(fightTimeline, tick, v);
+    dialogueStep = (int)v[DIALOGUE];
+    if (!battleSize) {
+        fighters.x[0] = v[MAN1_X];
+        fighters.x[1] = v[MAN2_X];
     }
+    crowdUpdate(crowd, tick, battleSize ? fighters.firstContact : (float)contactTick);
+    crowdTick = crowd.moving ? tick : -1;
 }
 
 // ---------------- Display ----------------
 void display() {
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    drawBackground();
-    drawCrowd();
-
-    // Draw Men
-    drawMan(man1X, man1Y, 0, 0, 1); // Blue man
-    drawMan(man2X, man2Y, 1, 0, 0); // Red man
-
-    // Display dialogues
-    if (dialogueStep == 0)
-        displayText("Man 1: You stole my idea!", -0.9f, 0.85f);
-    else if (dialogueStep == 1)
-        displayText("Man 2: It was mine first!", -0.9f, 0.85f);
-    else if (dialogueStep == 2)
-        displayText("They start fighting!", -0.9f, 0.85f);
-    else if (dialogueStep == 3)
-        displayText("Crowd: Fight! Fight! Fight!", -0.9f, 0.85f);
-
-    glutSwapBuffers();
+    glStatsBeginFrame();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    batchBeginFrame();
+
+    glStatsSceneBegin();
+    if (layerCacheBegin(backgroundLayer, 0)) {
+        drawBackground();
+        layerCacheEnd(backgroundLayer);
+    }
+    crowdDraw(crowd);
+
+    if (battleSize) {
+        battleDraw(fighters);
+        char status[64];
+        snprintf(status, sizeof(status), "Battle: %d fighters, %d fighting", fighters.count, fighters.fighting);
+        displayText(status, -0.9f, 0.85f);
+    }
+    else {
+        // Draw Men
+        for (int i = 0; i < fighters.count; ++i) {
+            const float* color = FIGHTER_TEAMS[fighters.team[i]];
+            drawMan(fighters.x[i], fighters.y[i], color[0], color[1], color[2]);
+        }
+
+        // Display dialogues
+        if (dialogueStep == 0)
+            displayText("Man 1: You stole my idea!", -0.9f, 0.85f);
+        else if (dialogueStep == 1)
+            displayText("Man 2: It was mine first!", -0.9f, 0.85f);
+        else if (dialogueStep == 2)
+            displayText("They start fighting!", -0.9f, 0.85f);
+        else if (dialogueStep == 3)
+            displayText("Crowd: Fight! Fight! Fight!", -0.9f, 0.85f);
+    }
+    glStatsSceneEnd();
+    glStatsDrawHud([](const char* s, float x, float y) { textQueue(s, x, y, batchNextLayerZ(), 0.9f, 0.4f, 0.0f); });
+
+    batchFlush();
+    textFlush();
+    glStatsEndFrame("fight", batch.stats.primitives + batch.stats.instances);
+    presentFrame();
 }
 
-// ---------------- Timer ----------------
-void timer(int value) {
+// ---------------- Story Step ----------------
+void stepStory() {
     timerCount++;
+    if (battleSize) battleStep(fighters);
+    applyTimeline((float)timerCount);
+}
 
-    // Dialogue timing control
-    if (timerCount == 100) dialogueStep = 1;
-    if (timerCount == 200 && !fighting) fighting = true;
-    if (timerCount == 400) dialogueStep = 3;
+// Jump to any tick (headless --start, scrubbing); a battle is simulated, so
+// it is replayed from the start
+void seekStory(int tick) {
+    timerCount = tick > 0 ? tick : 0;
+    if (battleSize) {
+        battleReset(fighters);
+        while (fighters.tick < timerCount) battleStep(fighters);
+    }
+    applyTimeline((float)timerCount);
+}
 
-    updateFight();
+// Whether the frame differs from the last one drawn: the men and the crowd
+// only move once the fight starts, so the dialogue lines before it are still
+// pictures. A battle moves on every tick.
+bool frameChanged() {
+    struct { float man1X, man2X, crowdTick; int battleTick, dialogueStep, hud; } visible = { fighters.x[0], fighters.x[1],
+        crowdTick, battleSize ? fighters.tick : -1, dialogueStep, glStats.hud };
+    return damageCheck(&visible, sizeof(visible));
+}
 
-    glutPostRedisplay();
-    glutTimerFunc(50, timer, 0);
+// ---------------- Idle ----------------
+// Runs the ticks due by the clock and shows the story in between the last two
+void idle() {
+    int steps = simClockAdvance(simClock);
+    for (int i = 0; i < steps; ++i) stepStory();
+    applyTimeline(fmaxf(0.0f, timerCount - 1 + simClockAlpha(simClock)));
+    if (frameChanged()) glutPostRedisplay();
+    else simClockWait(simClock);
 }
 
 // ---------------- Keyboard ----------------
 void keyboard(unsigned char key, int x, int y) {
-    if (key == 'f' || key == 'F') {
-        fighting = true;
-        collided = false;
-        dialogueStep = 1;
-        timerCount = 0;
-    }
+    if (key == 'f' || key == 'F') seekStory(FIGHT_START);
+    if (key == '[') seekStory(timerCount - SCRUB_TICKS);
+    if (key == ']') seekStory(timerCount + SCRUB_TICKS);
+    if (key == 'h' || key == 'H') glStatsToggleHud();
+    if (frameChanged()) glutPostRedisplay();
 }
 
 // ---------------- Init ----------------
@@ -162,19 +253,52 @@ void init() {
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
     gluOrtho2D(-1, 1, -1, 1);
+    batchInit2D();
+    crowdInit(crowd);
+    if (battleSize) battleInit(fighters, battleSize);
+    else {
+        fighterAdd(fighters, MAN1_START_X, MAN_Y, 0, 1.0f); // Blue man
+        fighterAdd(fighters, MAN2_START_X, MAN_Y, 1, 1.0f); // Red man
+    }
+    buildFightTimeline();
 }
 
 // ---------------- Main ----------------
 int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--battle") == 0 && i + 1 < argc) battleSize = atoi(argv[++i]);
+        else if (!glStatsParseArg(argc, argv, i) && !softRasterParseArg(argc, argv, i) && !crowdParseArg(argc, argv, i, crowd))
+            headlessParseArg(argc, argv, i); // anything else is left to glutInit
+    }
+    if (battleSize == 1) battleSize = 2; // one of each team
+    if (headless.enabled) {
+        if (softRaster.enabled) softRasterInit(headless.width, headless.height);
+        if (!headlessInitContext()) return 1;
+        init();
+        headless.vertexCounter = &glStats.totalVertices;
+        headless.seek = seekStory;
+        headlessRun(stepStory, display, frameChanged);
+        headlessWriteBench();
+        batchPrintStats();
+        layerCachePrintStats("background", backgroundLayer);
+        damagePrintStats();
+        timelinePrintStats("fight", fightTimeline);
+        crowdPrintStats(crowd);
+        sweepPrintStats("fighters", fighters.sweep);
+        softRasterPrintStats();
+        return 0;
+    }
+
     glutInit(&argc, argv);
-    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(800, 600);
     glutCreateWindow("Two Men Fighting - OpenGL Story Animation");
 
     init();
     glutDisplayFunc(display);
     glutKeyboardFunc(keyboard);
-    glutTimerFunc(50, timer, 0);
+    simClockInit(simClock, 20);
+    glutIdleFunc(idle);
 
     glutMainLoop();
     return 0;
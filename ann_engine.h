@@ -0,0 +1,322 @@
+// ann_engine.h
+// Feed-forward network trained with mini-batch backpropagation: tanh hidden
+// layers, sigmoid outputs, squared-error loss and plain SGD.
+//
+// Each layer's weights are one contiguous row-major buffer (row o holds the
+// weights into neuron o). Rows are padded with zeros to a multiple of 8 floats,
+// and so are the activation and error rows, so the SIMD kernels never need a
+// scalar tail. The forward pass, the backward pass and the weight gradients are
+// three small GEMMs built on a dot product and an axpy. Scalar, SSE and AVX
+// versions of those exist; the fastest the CPU supports is chosen at startup
+// unless a path is forced by name. A single-sample pass is the same GEMM with
+// one row (a GEMV).
+#pragma once
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const int ANN_PAD = 8;
+
+inline int annStride(int n) { return (n + ANN_PAD - 1) / ANN_PAD * ANN_PAD; }
+
+// Zeroed, 32-byte aligned floats, rounded up to a whole number of SIMD rows
+// (aligned_alloc needs a multiple of the alignment)
+inline float* annAlloc(size_t n) {
+    n = (n + ANN_PAD - 1) / ANN_PAD * ANN_PAD;
+    if (n == 0) n = ANN_PAD;
+    float* p = (float*)aligned_alloc(32, n * sizeof(float));
+    if (!p) {
+        fprintf(stderr, "ann: cannot allocate %zu floats\n", n);
+        exit(1);
+    }
+    memset(p, 0, n * sizeof(float));
+    return p;
+}
+
+struct AnnLayer {
+    int in = 0, out = 0;        // widths of the layer below and of this layer
+    int stride = 0;             // padded row length, annStride(in)
+    float* weights = nullptr;   // out x stride
+    float* bias = nullptr;      // out
+    float* gradW = nullptr;     // same shape as weights
+    float* gradB = nullptr;     // same shape as bias
+};
+
+struct AnnNetwork {
+    std::vector<int> widths;    // neurons per layer, input layer first
+    std::vector<AnnLayer> layers; // layers[l] maps widths[l] -> widths[l + 1]
+    int batch = 0;              // rows in the activation buffers
+    std::vector<float*> act;    // per layer: batch x annStride(width) activations
+    std::vector<float*> delta;  // per layer: batch x annStride(width) error terms
+};
+
+// Training set in the same padded row layout as the activations
+struct AnnDataset {
+    int rows = 0;
+    int inStride = 0, outStride = 0;
+    float* inputs = nullptr;    // rows x inStride
+    float* targets = nullptr;   // rows x outStride
+};
+
+// Small deterministic generator so weights and data don't depend on rand()
+inline float annRandom(unsigned& state) {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) * (2.0f / 16777216.0f) - 1.0f; // [-1, 1)
+}
+
+// ---------------- Kernels ----------------
+// n is always a multiple of ANN_PAD and the pointers are 32-byte aligned
+inline float annDotScalar(const float* a, const float* b, int n) {
+    float sum = 0;
+    for (int i = 0; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+inline void annAxpyScalar(float alpha, const float* x, float* y, int n) {
+    for (int i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+inline float annDotSSE(const float* a, const float* b, int n) {
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+    for (int i = 0; i < n; i += 8) {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_load_ps(a + i + 4), _mm_load_ps(b + i + 4)));
+    }
+    s0 = _mm_add_ps(s0, s1);
+    s0 = _mm_add_ps(s0, _mm_movehl_ps(s0, s0));
+    s0 = _mm_add_ss(s0, _mm_shuffle_ps(s0, s0, 1));
+    return _mm_cvtss_f32(s0);
+}
+
+inline void annAxpySSE(float alpha, const float* x, float* y, int n) {
+    __m128 a = _mm_set1_ps(alpha);
+    for (int i = 0; i < n; i += 4)
+        _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(a, _mm_load_ps(x + i))));
+}
+
+__attribute__((target("avx")))
+inline float annDotAVX(const float* a, const float* b, int n) {
+    __m256 s = _mm256_setzero_ps();
+    for (int i = 0; i < n; i += 8)
+        s = _mm256_add_ps(s, _mm256_mul_ps(_mm256_load_ps(a + i), _mm256_load_ps(b + i)));
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+    h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_add_ss(h, _mm_shuffle_ps(h, h, 1));
+    return _mm_cvtss_f32(h);
+}
+
+__attribute__((target("avx")))
+inline void annAxpyAVX(float alpha, const float* x, float* y, int n) {
+    __m256 a = _mm256_set1_ps(alpha);
+    for (int i = 0; i < n; i += 8)
+        _mm256_store_ps(y + i, _mm256_add_ps(_mm256_load_ps(y + i), _mm256_mul_ps(a, _mm256_load_ps(x + i))));
+}
+
+// ---------------- Path selection ----------------
+struct AnnPath {
+    const char* name;
+    float (*dot)(const float* a, const float* b, int n);
+    void (*axpy)(float alpha, const float* x, float* y, int n);
+};
+
+inline AnnPath annPath = { "scalar", annDotScalar, annAxpyScalar };
+
+// Pick kernels by name ("scalar", "sse", "avx"), or the best supported ones
+// for nullptr / "auto". Returns false if the named path isn't available.
+inline bool annSelectPath(const char* name) {
+    bool hasAVX = __builtin_cpu_supports("avx");
+    if (!name || strcmp(name, "auto") == 0) name = hasAVX ? "avx" : "sse";
+    if (strcmp(name, "avx") == 0 && hasAVX) annPath = { "avx", annDotAVX, annAxpyAVX };
+    else if (strcmp(name, "sse") == 0) annPath = { "sse", annDotSSE, annAxpySSE };
+    else if (strcmp(name, "scalar") == 0) annPath = { "scalar", annDotScalar, annAxpyScalar };
+    else return false;
+    return true;
+}
+
+// ---------------- GEMMs ----------------
+// Forward: Z[m][o] = bias[o] + A[m] . W[o] for m < rows. Each weight row is
+// used against every input row while it is still in cache.
+inline void annGemmForward(const AnnLayer& L, const float* A, float* Z, int zStride, int rows) {
+    for (int o = 0; o < L.out; ++o) {
+        const float* w = L.weights + (size_t)o * L.stride;
+        for (int m = 0; m < rows; ++m)
+            Z[(size_t)m * zStride + o] = L.bias[o] + annPath.dot(A + (size_t)m * L.stride, w, L.stride);
+    }
+}
+
+// Backward: D[m] = sum over o of E[m][o] * W[o] (D rows are cleared first)
+inline void annGemmBackward(const AnnLayer& L, const float* E, int eStride, float* D, int rows) {
+    for (int m = 0; m < rows; ++m) {
+        float* d = D + (size_t)m * L.stride;
+        memset(d, 0, L.stride * sizeof(float));
+        for (int o = 0; o < L.out; ++o)
+            annPath.axpy(E[(size_t)m * eStride + o], L.weights + (size_t)o * L.stride, d, L.stride);
+    }
+}
+
+// Gradient: gradW[o] = sum over m of E[m][o] * A[m], gradB[o] = sum of E[m][o]
+inline void annGemmGrad(AnnLayer& L, const float* E, int eStride, const float* A, int rows) {
+    for (int o = 0; o < L.out; ++o) {
+        float* g = L.gradW + (size_t)o * L.stride;
+        memset(g, 0, L.stride * sizeof(float));
+        float gb = 0;
+        for (int m = 0; m < rows; ++m) {
+            float e = E[(size_t)m * eStride + o];
+            annPath.axpy(e, A + (size_t)m * L.stride, g, L.stride);
+            gb += e;
+        }
+        L.gradB[o] = gb;
+    }
+}
+
+// ---------------- Network ----------------
+inline void annFree(AnnNetwork& net) {
+    for (AnnLayer& L : net.layers) { free(L.weights); free(L.bias); free(L.gradW); free(L.gradB); }
+    for (float* p : net.act) free(p);
+    for (float* p : net.delta) free(p);
+    net = AnnNetwork();
+}
+
+// Build a network with the given layer widths, weights uniform in
+// +-1/sqrt(fan-in), and activation buffers for `batch` rows
+inline void annInit(AnnNetwork& net, const std::vector<int>& widths, int batch, unsigned seed) {
+    annFree(net);
+    net.widths = widths;
+    net.batch = batch;
+    for (size_t l = 0; l + 1 < widths.size(); ++l) {
+        AnnLayer L;
+        L.in = widths[l];
+        L.out = widths[l + 1];
+        L.stride = annStride(L.in);
+        L.weights = annAlloc((size_t)L.out * L.stride);
+        L.gradW = annAlloc((size_t)L.out * L.stride);
+        L.bias = annAlloc(L.out);
+        L.gradB = annAlloc(L.out);
+        float scale = 1.0f / sqrtf((float)L.in);
+        for (int o = 0; o < L.out; ++o)
+            for (int i = 0; i < L.in; ++i) L.weights[(size_t)o * L.stride + i] = scale * annRandom(seed);
+        net.layers.push_back(L);
+    }
+    for (int w : widths) {
+        net.act.push_back(annAlloc((size_t)batch * annStride(w)));
+        net.delta.push_back(annAlloc((size_t)batch * annStride(w)));
+    }
+}
+
+// Run `rows` input rows (rows <= net.batch) through the network; the outputs
+// are left in net.act.back()
+inline void annForward(AnnNetwork& net, const float* inputs, int rows) {
+    memcpy(net.act[0], inputs, (size_t)rows * annStride(net.widths[0]) * sizeof(float));
+    for (size_t l = 0; l < net.layers.size(); ++l) {
+        const AnnLayer& L = net.layers[l];
+        float* z = net.act[l + 1];
+        int zStride = annStride(L.out);
+        annGemmForward(L, net.act[l], z, zStride, rows);
+        bool output = l + 1 == net.layers.size();
+        for (int m = 0; m < rows; ++m) {
+            float* row = z + (size_t)m * zStride;
+            for (int o = 0; o < L.out; ++o)
+                row[o] = output ? 1.0f / (1.0f + expf(-row[o])) : tanhf(row[o]);
+        }
+    }
+}
+
+// One SGD step on `rows` samples; returns their summed squared error
+inline float annTrainBatch(AnnNetwork& net, const float* inputs, const float* targets, int rows, float rate) {
+    annForward(net, inputs, rows);
+
+    // output error terms for squared error through the sigmoid
+    int last = (int)net.widths.size() - 1;
+    int outStride = annStride(net.widths[last]);
+    float loss = 0;
+    for (int m = 0; m < rows; ++m) {
+        const float* y = net.act[last] + (size_t)m * outStride;
+        const float* t = targets + (size_t)m * outStride;
+        float* e = net.delta[last] + (size_t)m * outStride;
+        for (int o = 0; o < net.widths[last]; ++o) {
+            float diff = y[o] - t[o];
+            loss += diff * diff;
+            e[o] = diff * y[o] * (1.0f - y[o]);
+        }
+    }
+
+    // walk back down: gradients for layer l, then the error terms of the layer below
+    float step = rate / rows;
+    for (int l = (int)net.layers.size() - 1; l >= 0; --l) {
+        AnnLayer& L = net.layers[l];
+        int eStride = annStride(L.out);
+        annGemmGrad(L, net.delta[l + 1], eStride, net.act[l], rows);
+        if (l > 0) {
+            annGemmBackward(L, net.delta[l + 1], eStride, net.delta[l], rows);
+            for (int m = 0; m < rows; ++m) {
+                const float* a = net.act[l] + (size_t)m * L.stride;
+                float* d = net.delta[l] + (size_t)m * L.stride;
+                for (int i = 0; i < L.in; ++i) d[i] *= 1.0f - a[i] * a[i]; // tanh'
+            }
+        }
+        annPath.axpy(-step, L.gradW, L.weights, L.out * L.stride);
+        for (int o = 0; o < L.out; ++o) L.bias[o] -= step * L.gradB[o];
+    }
+    return loss;
+}
+
+// One pass over the dataset in mini-batches; returns the mean squared error
+inline float annTrainEpoch(AnnNetwork& net, const AnnDataset& data, float rate) {
+    float loss = 0;
+    for (int row = 0; row < data.rows; row += net.batch) {
+        int rows = data.rows - row < net.batch ? data.rows - row : net.batch;
+        loss += annTrainBatch(net, data.inputs + (size_t)row * data.inStride,
+            data.targets + (size_t)row * data.outStride, rows, rate);
+    }
+    return loss / ((float)data.rows * net.widths.back());
+}
+
+// ---------------- Built-in dataset ----------------
+inline void annFreeDataset(AnnDataset& d) {
+    free(d.inputs); free(d.targets);
+    d = AnnDataset();
+}
+
+// Inputs uniform in [-1, 1]; each target is a smooth nonlinear function of a
+// fixed random projection of the input (a "teacher"), so any topology has
+// something learnable to fit
+inline void annMakeDataset(AnnDataset& d, int inputs, int outputs, int rows, unsigned seed) {
+    annFreeDataset(d);
+    d.rows = rows;
+    d.inStride = annStride(inputs);
+    d.outStride = annStride(outputs);
+    d.inputs = annAlloc((size_t)rows * d.inStride);
+    d.targets = annAlloc((size_t)rows * d.outStride);
+    std::vector<float> teacher((size_t)outputs * inputs);
+    for (float& t : teacher) t = annRandom(seed);
+    float scale = 2.0f / sqrtf((float)inputs);
+    for (int m = 0; m < rows; ++m) {
+        float* x = d.inputs + (size_t)m * d.inStride;
+        for (int i = 0; i < inputs; ++i) x[i] = annRandom(seed);
+        for (int o = 0; o < outputs; ++o) {
+            float s = 0;
+            for (int i = 0; i < inputs; ++i) s += teacher[(size_t)o * inputs + i] * x[i];
+            d.targets[(size_t)m * d.outStride + o] = 0.5f + 0.4f * sinf(scale * s);
+        }
+    }
+}
+
+// Parse "3,4,2" into layer widths; needs at least two positive widths
+inline bool annParseLayers(const char* spec, std::vector<int>& widths) {
+    widths.clear();
+    const char* p = spec;
+    while (*p) {
+        char* end;
+        long w = strtol(p, &end, 10);
+        if (end == p || w < 1) return false;
+        widths.push_back((int)w);
+        p = end;
+        if (*p == ',') p++;
+        else if (*p) return false;
+    }
+    return widths.size() >= 2;
+}
@@ -0,0 +1,45 @@
+// ann_bench.cpp
+// Training throughput (samples/sec) of the backprop engine for each kernel
+// path on a few network shapes, from the visualizer's default up to wide layers.
+// Compile (Linux): g++ -O2 bench/ann_bench.cpp -o ann_bench
+
+#include "../ann_engine.h"
+#include <chrono>
+#include <cstdio>
+
+static double samplesPerSec(const std::vector<int>& widths) {
+    typedef std::chrono::steady_clock Clock;
+    AnnNetwork net;
+    AnnDataset data;
+    annInit(net, widths, 16, 12345u);
+    annMakeDataset(data, widths.front(), widths.back(), 256, 777u);
+
+    long long macs = 0; // multiply-adds per sample in one forward pass
+    for (size_t l = 0; l + 1 < widths.size(); ++l) macs += (long long)widths[l] * widths[l + 1];
+    int epochs = (int)(2e9 / (3.0 * macs * data.rows)); // ~2G multiply-adds per measurement
+    if (epochs < 2) epochs = 2;
+
+    annTrainEpoch(net, data, 0.1f); // warm the caches
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < epochs; ++i) annTrainEpoch(net, data, 0.1f);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    annFree(net);
+    annFreeDataset(data);
+    return (double)epochs * 256 * 1000.0 / ms;
+}
+
+int main() {
+    const char* paths[] = { "scalar", "sse", "avx" };
+    const std::vector<int> shapes[] = { { 3, 4, 2 }, { 32, 64, 64, 8 }, { 64, 256, 256, 10 }, { 784, 512, 10 } };
+    const char* names[] = { "3,4,2", "32,64,64,8", "64,256,256,10", "784,512,10" };
+    printf("%8s", "path");
+    for (const char* n : names) printf(" %16s", n);
+    printf("   (training samples/sec)\n");
+    for (const char* path : paths) {
+        if (!annSelectPath(path)) { printf("%8s (not supported on this CPU)\n", path); continue; }
+        printf("%8s", path);
+        for (const std::vector<int>& shape : shapes) printf(" %16.0f", samplesPerSec(shape));
+        printf("\n");
+    }
+    return 0;
+}
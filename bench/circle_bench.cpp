@@ -0,0 +1,51 @@
+// circle_bench.cpp
+// Microbenchmark: circles per second when tessellating with cosf/sinf per vertex
+// (the old drawCircle loop) versus scaling the shared unit-circle cache.
+// Only vertex generation is timed, GL submission is the same for both.
+// Compile (Linux): g++ -O2 bench/circle_bench.cpp -o circle_bench
+
+#define GL_GLEXT_PROTOTYPES
+#include "../circle_cache.h"
+#include <chrono>
+#include <cstdio>
+
+static float sink[2 * (CIRCLE_CACHE_MAX_SEGMENTS + 1)];
+
+// The loop drawCircle used before the cache
+static void trigCircle(float* out, float cx, float cy, float r, int segments) {
+    for (int i = 0; i < segments; ++i) {
+        float theta = 2.0f * 3.1415926f * float(i) / float(segments);
+        out[2 * i] = cx + r * cosf(theta);
+        out[2 * i + 1] = cy + r * sinf(theta);
+    }
+}
+
+static void cachedCircle(float* out, float cx, float cy, float r, int segments) {
+    circleVertices(out, segments, cx, cy, r, r, segments);
+}
+
+static double circlesPerSec(void (*fn)(float*, float, float, float, int), int segments) {
+    typedef std::chrono::steady_clock Clock;
+    const int circles = 4000000 / segments;
+    float acc = 0;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < circles; ++i) {
+        fn(sink, i * 1e-6f, -i * 1e-6f, 0.1f + (i & 7) * 0.01f, segments);
+        acc += sink[segments]; // keep the work observable
+    }
+    double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    if (acc == 12345.0f) printf(" ");
+    return circles / sec;
+}
+
+int main() {
+    const int segmentCounts[] = { 36, 64, 360 };
+    printf("%9s %16s %16s %8s\n", "segments", "trig circles/s", "cached circles/s", "speedup");
+    for (int segments : segmentCounts) {
+        unitCircle(segments); // tessellate once, outside the timed loop
+        double before = circlesPerSec(trigCircle, segments);
+        double after = circlesPerSec(cachedCircle, segments);
+        printf("%9d %16.0f %16.0f %7.2fx\n", segments, before, after, after / before);
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+// raster_bench.cpp
+// GL against the software rasterizer (soft_raster.h): renders each of the ten
+// storyboard scenes headless at 720p, 1080p and 4K both ways and prints the
+// median frame time of each, with the speedup of the software path.
+//
+// Compile (Linux): g++ -O2 bench/raster_bench.cpp -o raster_bench
+// The story program must be built first, as for scene_bench (run from the
+// repository root).
+// Usage: raster_bench [--bin DIR] [--frames N] [--threads N] [--only SCENE]
+// --threads is passed on as --raster-threads (default: one per hardware thread).
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+const int WARMUP_FRAMES = 5;
+
+static const char* STORY = "many_types_story_project";
+static const char* SIZES[] = { "1280x720", "1920x1080", "3840x2160" };
+
+// Number after "key": in a flat JSON object, or NAN
+static double jsonNumber(const std::string& obj, const char* key) {
+    std::string k = std::string("\"") + key + "\":";
+    size_t at = obj.find(k);
+    if (at == std::string::npos) return NAN;
+    return strtod(obj.c_str() + at + k.size(), nullptr);
+}
+
+static bool readFile(const char* path, std::string& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    out.clear();
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+// Median frame time of one run in ms, or NAN when it failed
+static double medianMs(const char* binDir, int scene, const char* size, int frames, const std::string& extra) {
+    char tmp[] = "/tmp/raster_bench_XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0) return NAN;
+    close(fd);
+    std::string cmd = std::string("'") + binDir + "/" + STORY + "' --headless --scene " + std::to_string(scene) +
+        " --frames " + std::to_string(frames + WARMUP_FRAMES) + " --warmup " + std::to_string(WARMUP_FRAMES) +
+        " --size " + size + extra + " --bench-json " + tmp + " > /dev/null";
+    std::string line;
+    double ms = NAN;
+    if (system(cmd.c_str()) == 0 && readFile(tmp, line)) ms = jsonNumber(line, "median_ms");
+    unlink(tmp);
+    return ms;
+}
+
+int main(int argc, char** argv) {
+    const char* binDir = ".";
+    int frames = 30, threads = 0, only = 0;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--bin") == 0 && hasValue) binDir = argv[++i];
+        else if (strcmp(argv[i], "--frames") == 0 && hasValue) frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--only") == 0 && hasValue) only = atoi(argv[++i]);
+        else { fprintf(stderr, "unknown option %s\n", argv[i]); return 2; }
+    }
+    std::string soft = " --soft-raster";
+    if (threads > 0) soft += " --raster-threads " + std::to_string(threads);
+
+    printf("%-8s %-10s %10s %10s %8s\n", "scene", "size", "GL ms", "soft ms", "speedup");
+    int failures = 0;
+    for (int scene = 1; scene <= 10; ++scene) {
+        if (only && scene != only) continue;
+        for (const char* size : SIZES) {
+            double gl = medianMs(binDir, scene, size, frames, "");
+            double sw = medianMs(binDir, scene, size, frames, soft);
+            if (std::isnan(gl) || std::isnan(sw)) {
+                printf("%-8d %-10s failed to run (is '%s' built in %s?)\n", scene, size, STORY, binDir);
+                failures++;
+                continue;
+            }
+            printf("%-8d %-10s %10.3f %10.3f %7.2fx\n", scene, size, gl, sw, sw > 0 ? gl / sw : 0.0);
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+// scene_bench.cpp
+// Benchmark suite over every scene: runs each program headless for a fixed
+// number of frames (after a few unmeasured warm-up frames), collects median /
+// p99 frame time, vertices/sec and simulation steps/sec, writes them as JSON
+// and compares them with a stored baseline.
+//
+// Workloads: the ten storyboard scenes, Dengue at 1k / 10k / 50k mosquitoes,
+// People Fighting through its whole dialogue timeline and the ANN visualizer
+// at three network sizes.
+//
+// Compile (Linux): g++ -O2 bench/scene_bench.cpp -o scene_bench
+// The programs must be built first, named after their sources, e.g.
+//   g++ -O2 "Dengue Awareness.cpp" -lGL -lGLU -lglut -lEGL -pthread -o "Dengue Awareness"
+// (run from the repository root, where the story program finds its storyboard).
+// Usage: scene_bench [--bin DIR] [--frames N] [--size WxH] [--only TEXT]
+//                    [--out FILE] [--baseline FILE] [--threshold PERCENT]
+// Exits with 1 when a workload regressed by more than the threshold.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+struct Workload {
+    std::string name;
+    const char* program;
+    std::string args;
+    int frames;         // 0: use --frames
+};
+
+const int WARMUP_FRAMES = 5; // shader compiles, first-touch allocations
+// Steps faster than this (a frame counter bump) are timer noise, not compared
+const double MAX_COMPARED_STEPS_PER_SEC = 20000;
+
+struct BenchResult {
+    std::string name;
+    double medianMs = 0, p99Ms = 0, verticesPerSec = 0, stepsPerSec = 0;
+    bool ok = false;
+};
+
+static const char* STORY = "many_types_story_project";
+static const char* DENGUE = "Dengue Awareness";
+static const char* FIGHT = "People Fighting(Story Base)";
+static const char* ANN = "ANN visualization";
+
+static std::vector<Workload> workloads() {
+    std::vector<Workload> w;
+    for (int s = 1; s <= 10; ++s)
+        w.push_back({ "story/scene" + std::to_string(s), STORY, "--scene " + std::to_string(s), 0 });
+    const int swarms[] = { 1000, 10000, 50000 };
+    for (int n : swarms)
+        w.push_back({ "dengue/" + std::to_string(n), DENGUE, "--mosquitoes " + std::to_string(n), 0 });
+    w.push_back({ "fight/timeline", FIGHT, "", 450 }); // last dialogue cue is at step 400
+    const char* nets[] = { "3,4,2", "32,64,64,8", "64,256,256,10" };
+    for (const char* n : nets)
+        w.push_back({ std::string("ann/") + n, ANN, std::string("--layers ") + n, 0 });
+    return w;
+}
+
+// Number after "key": in a flat JSON object, or NAN
+static double jsonNumber(const std::string& obj, const char* key) {
+    std::string k = std::string("\"") + key + "\":";
+    size_t at = obj.find(k);
+    if (at == std::string::npos) return NAN;
+    return strtod(obj.c_str() + at + k.size(), nullptr);
+}
+
+static bool readFile(const char* path, std::string& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    out.clear();
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+static BenchResult run(const Workload& w, const char* binDir, int frames, const char* size) {
+    BenchResult r;
+    r.name = w.name;
+    char tmp[] = "/tmp/scene_bench_XXXXXX";
+    int fd = mkstemp(tmp);
+    if (fd < 0) return r;
+    close(fd);
+    std::string cmd = std::string("'") + binDir + "/" + w.program + "' --headless --frames " +
+        std::to_string((w.frames ? w.frames : frames) + WARMUP_FRAMES) +
+        " --warmup " + std::to_string(WARMUP_FRAMES) + " --size " + size + " " + w.args +
+        " --bench-json " + tmp + " > /dev/null";
+    std::string line;
+    if (system(cmd.c_str()) == 0 && readFile(tmp, line) && !line.empty()) {
+        r.medianMs = jsonNumber(line, "median_ms");
+        r.p99Ms = jsonNumber(line, "p99_ms");
+        r.verticesPerSec = jsonNumber(line, "vertices_per_sec");
+        r.stepsPerSec = jsonNumber(line, "steps_per_sec");
+        r.ok = !std::isnan(r.medianMs);
+    }
+    unlink(tmp);
+    return r;
+}
+
+static void writeJson(const char* path, const std::vector<BenchResult>& results, int frames, const char* size) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "cannot write %s\n", path); return; }
+    fprintf(f, "{\n  \"frames\": %d,\n  \"size\": \"%s\",\n  \"workloads\": [\n", frames, size);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"median_ms\": %.4f, \"p99_ms\": %.4f, "
+            "\"vertices_per_sec\": %.0f, \"steps_per_sec\": %.1f}%s\n",
+            r.name.c_str(), r.medianMs, r.p99Ms, r.verticesPerSec, r.stepsPerSec,
+            i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+// Baseline entry for a workload, from a file written by writeJson()
+static bool baselineFor(const std::string& baseline, const std::string& name, BenchResult& b) {
+    size_t at = baseline.find("\"name\": \"" + name + "\"");
+    if (at == std::string::npos) return false;
+    std::string obj = baseline.substr(at, baseline.find('}', at) - at);
+    b.medianMs = jsonNumber(obj, "median_ms");
+    b.p99Ms = jsonNumber(obj, "p99_ms");
+    b.verticesPerSec = jsonNumber(obj, "vertices_per_sec");
+    b.stepsPerSec = jsonNumber(obj, "steps_per_sec");
+    return true;
+}
+
+// Percent change from base to now, signed so that positive is worse
+static double worse(double base, double now, bool lowerIsBetter) {
+    if (!(base > 0)) return 0;
+    return (lowerIsBetter ? now - base : base - now) * 100.0 / base;
+}
+
+int main(int argc, char** argv) {
+    const char* binDir = ".";
+    const char* outPath = "scene_bench.json";
+    const char* baselinePath = nullptr;
+    const char* only = nullptr;
+    const char* size = "800x600";
+    int frames = 60;
+    double threshold = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--bin") == 0 && hasValue) binDir = argv[++i];
+        else if (strcmp(argv[i], "--frames") == 0 && hasValue) frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--size") == 0 && hasValue) size = argv[++i];
+        else if (strcmp(argv[i], "--only") == 0 && hasValue) only = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && hasValue) outPath = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && hasValue) baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && hasValue) threshold = atof(argv[++i]);
+        else { fprintf(stderr, "unknown option %s\n", argv[i]); return 2; }
+    }
+    std::string baseline;
+    if (baselinePath && !readFile(baselinePath, baseline)) {
+        fprintf(stderr, "cannot read baseline %s\n", baselinePath);
+        return 2;
+    }
+
+    printf("%-22s %10s %10s %14s %12s", "workload", "median ms", "p99 ms", "vertices/s", "steps/s");
+    if (baselinePath) printf("   vs baseline (+ is worse, threshold %.0f%%)", threshold);
+    printf("\n");
+
+    std::vector<BenchResult> results;
+    int regressions = 0, failures = 0;
+    for (const Workload& w : workloads()) {
+        if (only && w.name.find(only) == std::string::npos) continue;
+        BenchResult r = run(w, binDir, frames, size);
+        if (!r.ok) {
+            printf("%-22s failed to run (is '%s' built in %s?)\n", w.name.c_str(), w.program, binDir);
+            failures++;
+            continue;
+        }
+        results.push_back(r);
+        printf("%-22s %10.3f %10.3f %14.0f %12.1f", r.name.c_str(), r.medianMs, r.p99Ms, r.verticesPerSec, r.stepsPerSec);
+        BenchResult b;
+        if (baselinePath && baselineFor(baseline, r.name, b)) {
+            double dMedian = worse(b.medianMs, r.medianMs, true);
+            double dP99 = worse(b.p99Ms, r.p99Ms, true);
+            bool stepsCompared = b.stepsPerSec < MAX_COMPARED_STEPS_PER_SEC;
+            double dSteps = stepsCompared ? worse(b.stepsPerSec, r.stepsPerSec, false) : 0;
+            bool regressed = dMedian > threshold || dP99 > threshold || dSteps > threshold;
+            printf("   median %+6.1f%%  p99 %+6.1f%%", dMedian, dP99);
+            if (stepsCompared) printf("  steps %+6.1f%%", dSteps);
+            else printf("  %13s", "");
+            printf("%s", regressed ? "  REGRESSION" : "");
+            if (regressed) regressions++;
+        }
+        else if (baselinePath) printf("   (not in baseline)");
+        printf("\n");
+    }
+
+    writeJson(outPath, results, frames, size);
+    printf("wrote %s", outPath);
+    if (baselinePath) printf(", %d regression(s) over %.0f%%", regressions, threshold);
+    printf("\n");
+    return regressions > 0 || failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+// spatial_grid_bench.cpp
+// Cost of a spray-sized proximity query (radius 0.1) through the spatial grid
+// versus a brute-force scan of the whole swarm, plus the cost of the
+// incremental grid update after each swarm step, at 1K to 1M mosquitoes.
+// Compile (Linux): g++ -O2 bench/spatial_grid_bench.cpp -pthread -o spatial_grid_bench
+
+#include "../mosquito_swarm.h"
+#include "../spatial_grid.h"
+#include <chrono>
+#include <cstdio>
+
+typedef std::chrono::steady_clock Clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+static int bruteForceQuery(const MosquitoSwarm& s, float cx, float cy, float r) {
+    int hits = 0;
+    for (int i = 0; i < s.count; ++i) {
+        float dx = s.x[i] - cx, dy = s.y[i] - cy;
+        if (dx * dx + dy * dy <= r * r) hits++;
+    }
+    return hits;
+}
+
+int main() {
+    const int sizes[] = { 1000, 10000, 100000, 1000000 };
+    const int QUERIES = 256, STEPS = 20;
+    const float R = 0.1f;
+    swarmSelectPath(nullptr);
+
+    float qx[QUERIES], qy[QUERIES];
+    srand(7);
+    for (int q = 0; q < QUERIES; ++q) {
+        qx[q] = (rand() % 200 - 100) / 100.0f;
+        qy[q] = (rand() % 200 - 100) / 100.0f;
+    }
+
+    printf("%9s %14s %14s %9s %12s %16s %10s\n", "agents", "grid us/query", "brute us/query",
+        "speedup", "hits/query", "update ms/step", "moved/step");
+    for (int n : sizes) {
+        MosquitoSwarm s;
+        srand(1);
+        swarmInit(s, n);
+        SpatialGrid grid;
+        gridBuild(grid, 32, s.x, s.y, s.count);
+
+        // incremental re-bucketing after each step
+        double updateMs = 0;
+        long long moved = 0;
+        for (int i = 0; i < STEPS; ++i) {
+            swarmUpdate(s);
+            Clock::time_point t0 = Clock::now();
+            moved += gridUpdate(grid, s.x, s.y);
+            updateMs += msSince(t0);
+        }
+
+        std::vector<int> hits;
+        long long gridHits = 0, bruteHits = 0;
+        Clock::time_point t0 = Clock::now();
+        for (int q = 0; q < QUERIES; ++q) {
+            hits.clear();
+            gridQueryCircle(grid, s.x, s.y, qx[q], qy[q], R, hits);
+            gridHits += hits.size();
+        }
+        double gridMs = msSince(t0);
+
+        t0 = Clock::now();
+        for (int q = 0; q < QUERIES; ++q) bruteHits += bruteForceQuery(s, qx[q], qy[q], R);
+        double bruteMs = msSince(t0);
+
+        if (gridHits != bruteHits) printf("MISMATCH: grid %lld hits, brute force %lld\n", gridHits, bruteHits);
+        printf("%9d %14.2f %14.2f %8.1fx %12.1f %16.3f %10lld\n", n,
+            gridMs * 1000.0 / QUERIES, bruteMs * 1000.0 / QUERIES, bruteMs / gridMs,
+            (double)gridHits / QUERIES, updateMs / STEPS, moved / STEPS);
+        swarmFree(s);
+    }
+    return 0;
+}
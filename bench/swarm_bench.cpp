@@ -0,0 +1,36 @@
+// swarm_bench.cpp
+// Mosquito swarm update throughput (agents/ms) for each kernel at 1K, 100K and
+// 1M agents.
+// Compile (Linux): g++ -O2 bench/swarm_bench.cpp -o swarm_bench
+
+#include "../mosquito_swarm.h"
+#include <chrono>
+#include <cstdio>
+
+static double agentsPerMs(int agents) {
+    typedef std::chrono::steady_clock Clock;
+    MosquitoSwarm s;
+    srand(1);
+    swarmInit(s, agents);
+    int steps = 200000000 / agents; // ~200M agent updates per measurement
+    if (steps < 10) steps = 10;
+    swarmUpdate(s); // warm the caches
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < steps; ++i) swarmUpdate(s);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    swarmFree(s);
+    return (double)agents * steps / ms;
+}
+
+int main() {
+    const char* paths[] = { "scalar", "sse", "avx" };
+    const int sizes[] = { 1000, 100000, 1000000 };
+    printf("%8s %14s %14s %14s\n", "path", "1K agents/ms", "100K agents/ms", "1M agents/ms");
+    for (const char* path : paths) {
+        if (!swarmSelectPath(path)) { printf("%8s (not supported on this CPU)\n", path); continue; }
+        printf("%8s", path);
+        for (int n : sizes) printf(" %14.0f", agentsPerMs(n));
+        printf("\n");
+    }
+    return 0;
+}
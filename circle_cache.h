@@ -0,0 +1,56 @@
+// circle_cache.h
+// Shared unit-circle vertex cache. Each segment count is tessellated once (the
+// first time it is asked for) and every circle, ellipse or fan is then just a
+// scale + translate of the cached (cos, sin) table, so no trig runs per frame.
+#pragma once
+
+#include "render_batch.h"
+#include <cmath>
+#include <vector>
+
+const int CIRCLE_CACHE_MAX_SEGMENTS = 1024;
+
+// (cos, sin) pairs for angles 2*pi*i/segments, i = 0..segments (the last pair
+// repeats the first so fans and strips can close without wrapping)
+inline const float* unitCircle(int segments) {
+    static std::vector<float> tables[CIRCLE_CACHE_MAX_SEGMENTS + 1];
+    if (segments < 3) segments = 3;
+    if (segments > CIRCLE_CACHE_MAX_SEGMENTS) segments = CIRCLE_CACHE_MAX_SEGMENTS;
+    std::vector<float>& t = tables[segments];
+    if (t.empty()) {
+        t.resize(2 * (segments + 1));
+        for (int i = 0; i < segments; ++i) {
+            double a = 2.0 * 3.14159265358979323846 * i / segments;
+            t[2 * i] = (float)cos(a);
+            t[2 * i + 1] = (float)sin(a);
+        }
+        t[2 * segments] = t[0];
+        t[2 * segments + 1] = t[1];
+    }
+    return t.data();
+}
+
+// Write `count` ellipse points (starting at angle 0) into out as x, y pairs
+inline void circleVertices(float* out, int count, float cx, float cy, float rx, float ry, int segments) {
+    const float* uc = unitCircle(segments);
+    for (int i = 0; i < count; ++i) {
+        out[2 * i] = cx + rx * uc[2 * i];
+        out[2 * i + 1] = cy + ry * uc[2 * i + 1];
+    }
+}
+
+// Draw an ellipse outline or fill from the cache into the frame batch. GL_TRIANGLE_FAN gets a centre
+// vertex plus a closed rim, GL_POLYGON and GL_LINE_LOOP get the open rim (GL
+// closes them), anything else gets the closed rim.
+inline void drawEllipse(GLenum mode, float cx, float cy, float rx, float ry, int segments) {
+    if (segments < 3) segments = 3;
+    if (segments > CIRCLE_CACHE_MAX_SEGMENTS) segments = CIRCLE_CACHE_MAX_SEGMENTS;
+    int count = (mode == GL_POLYGON || mode == GL_LINE_LOOP) ? segments : segments + 1;
+    float pts[2 * (CIRCLE_CACHE_MAX_SEGMENTS + 1)];
+    circleVertices(pts, count, cx, cy, rx, ry, segments);
+
+    batchBegin(mode);
+    if (mode == GL_TRIANGLE_FAN) batchVertex2f(cx, cy);
+    for (int i = 0; i < count; ++i) batchVertex2f(pts[2 * i], pts[2 * i + 1]);
+    batchEnd();
+}
@@ -0,0 +1,174 @@
+// connection_lod.h
+// Level of detail for the edges between two neuron columns. Instead of one line
+// per weight, each frame:
+//   - bundles neighbouring neurons into clusters when they are closer than a
+//     few pixels on screen, or when there are more edges than the budget allows,
+//     and draws one edge per cluster pair with the mean |weight| of its block
+//     (estimated from at most 8 x 8 evenly spaced weights, so the cost follows
+//     the budget rather than the layer widths);
+//   - culls edges whose endpoints are both outside the same clip plane;
+//   - drops edges fainter than a fraction of the strongest one.
+// The number of edges produced never exceeds the budget.
+#pragma once
+
+#include <GL/gl.h>
+#include <cmath>
+#include <vector>
+
+// One edge to draw, strength in [0, 1] relative to the strongest in its column pair
+struct LodEdge {
+    float ax, ay, az, bx, by, bz;
+    float strength;
+};
+
+struct EdgeLodSettings {
+    int budget = 20000;     // most edges drawn per frame, over all column pairs
+    float faint = 0.05f;    // drop edges weaker than this fraction of the strongest
+    float minPixels = 3.0f; // bundle neurons closer than this on screen
+};
+
+// Per-frame counters, summed over column pairs
+struct EdgeLodStats {
+    long long weights = 0;  // weights that exist
+    int bundles = 0;        // edges after bundling
+    int culled = 0;         // bundled edges outside the view
+    int faint = 0;          // bundled edges too weak to show
+    int drawn = 0;
+};
+
+// Combined modelview-projection and viewport, captured once per frame after the
+// camera is set
+struct EdgeLodView {
+    float mvp[16];
+    float width, height;
+};
+
+inline void edgeLodCaptureView(EdgeLodView& v) {
+    float mv[16], proj[16];
+    int viewport[4];
+    glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+    glGetFloatv(GL_PROJECTION_MATRIX, proj);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r) {
+            float s = 0;
+            for (int k = 0; k < 4; ++k) s += proj[k * 4 + r] * mv[c * 4 + k];
+            v.mvp[c * 4 + r] = s;
+        }
+    v.width = (float)viewport[2];
+    v.height = (float)viewport[3];
+}
+
+inline void edgeLodClip(const EdgeLodView& v, const float* p, float clip[4]) {
+    for (int r = 0; r < 4; ++r)
+        clip[r] = v.mvp[r] * p[0] + v.mvp[4 + r] * p[1] + v.mvp[8 + r] * p[2] + v.mvp[12 + r];
+}
+
+// Bit per clip plane the point is outside of
+inline unsigned edgeLodOutcode(const EdgeLodView& v, const float* p) {
+    float c[4];
+    edgeLodClip(v, p, c);
+    return (c[0] < -c[3]) | (c[0] > c[3]) << 1 | (c[1] < -c[3]) << 2 |
+        (c[1] > c[3]) << 3 | (c[2] < -c[3]) << 4 | (c[2] > c[3]) << 5;
+}
+
+// Average on-screen distance in pixels between neighbours of a column of n
+// points (xyz triples), from its two ends
+inline float edgeLodPixelSpacing(const EdgeLodView& v, const float* xyz, int n) {
+    if (n < 2) return 1e9f;
+    float a[4], b[4];
+    edgeLodClip(v, xyz, a);
+    edgeLodClip(v, xyz + 3 * (n - 1), b);
+    if (a[3] <= 0 || b[3] <= 0) return 1e9f; // behind the eye: don't bundle on its account
+    float dx = (a[0] / a[3] - b[0] / b[3]) * 0.5f * v.width;
+    float dy = (a[1] / a[3] - b[1] / b[3]) * 0.5f * v.height;
+    return sqrtf(dx * dx + dy * dy) / (n - 1);
+}
+
+// Neurons per cluster for a wanted cluster size, between 1 and n
+inline int edgeLodClusterSize(float k, int n) {
+    if (!(k < n)) return n; // also catches inf / NaN from coincident points
+    return k > 1.0f ? (int)ceilf(k) : 1;
+}
+
+// Group n points into clusters of k consecutive ones: mean position and the
+// AND of the members' outcodes (a cluster is out only if all of it is)
+inline void edgeLodClusters(const EdgeLodView& v, const float* xyz, int n, int k,
+    std::vector<float>& pos, std::vector<unsigned>& outcode) {
+    int count = (n + k - 1) / k;
+    pos.assign(3 * count, 0.0f);
+    outcode.assign(count, ~0u);
+    for (int i = 0; i < n; ++i) {
+        int c = i / k;
+        pos[3 * c] += xyz[3 * i];
+        pos[3 * c + 1] += xyz[3 * i + 1];
+        pos[3 * c + 2] += xyz[3 * i + 2];
+        outcode[c] &= edgeLodOutcode(v, xyz + 3 * i);
+    }
+    for (int c = 0; c < count; ++c) {
+        int members = (c + 1) * k <= n ? k : n - c * k;
+        for (int j = 0; j < 3; ++j) pos[3 * c + j] /= members;
+    }
+}
+
+// Append the edges to draw from column a (na xyz triples) to column b, where
+// w[j * stride + i] is the weight from a[i] to b[j]. At most `budget` edges.
+inline void edgeLodBuild(const EdgeLodView& view, const EdgeLodSettings& s, int budget,
+    const float* a, int na, const float* b, int nb, const float* w, int stride,
+    std::vector<LodEdge>& out, EdgeLodStats& stats) {
+    if (budget < 1) budget = 1;
+    // cluster sizes: close enough on screen to merge, then coarser until within budget
+    int ka = edgeLodClusterSize(s.minPixels / edgeLodPixelSpacing(view, a, na), na);
+    int kb = edgeLodClusterSize(s.minPixels / edgeLodPixelSpacing(view, b, nb), nb);
+    int ca = (na + ka - 1) / ka, cb = (nb + kb - 1) / kb;
+    while ((long long)ca * cb > budget) {
+        if (ca >= cb) { ka++; ca = (na + ka - 1) / ka; }
+        else { kb++; cb = (nb + kb - 1) / kb; }
+    }
+
+    // mean |weight| per cluster pair, sampled every sa-th column and sb-th row
+    int sa = (ka + 7) / 8, sb = (kb + 7) / 8;
+    static std::vector<float> block;
+    static std::vector<int> samples;
+    block.assign((size_t)ca * cb, 0.0f);
+    samples.assign((size_t)ca * cb, 0);
+    for (int cj = 0; cj < cb; ++cj) {
+        int endJ = (cj + 1) * kb < nb ? (cj + 1) * kb : nb;
+        float* row = &block[(size_t)cj * ca];
+        int* rowSamples = &samples[(size_t)cj * ca];
+        for (int j = cj * kb; j < endJ; j += sb) {
+            const float* wj = w + (size_t)j * stride;
+            for (int ci = 0; ci < ca; ++ci) {
+                int endI = (ci + 1) * ka < na ? (ci + 1) * ka : na;
+                for (int i = ci * ka; i < endI; i += sa) {
+                    row[ci] += fabsf(wj[i]);
+                    rowSamples[ci]++;
+                }
+            }
+        }
+    }
+    float strongest = 1e-12f;
+    for (size_t c = 0; c < block.size(); ++c) {
+        block[c] /= (float)samples[c];
+        if (block[c] > strongest) strongest = block[c];
+    }
+
+    static std::vector<float> posA, posB;
+    static std::vector<unsigned> codeA, codeB;
+    edgeLodClusters(view, a, na, ka, posA, codeA);
+    edgeLodClusters(view, b, nb, kb, posB, codeB);
+
+    stats.weights += (long long)na * nb;
+    stats.bundles += ca * cb;
+    for (int ci = 0; ci < ca; ++ci) {
+        for (int cj = 0; cj < cb; ++cj) {
+            if (codeA[ci] & codeB[cj]) { stats.culled++; continue; }
+            float strength = block[(size_t)cj * ca + ci] / strongest;
+            if (strength < s.faint) { stats.faint++; continue; }
+            LodEdge e = { posA[3 * ci], posA[3 * ci + 1], posA[3 * ci + 2],
+                posB[3 * cj], posB[3 * cj + 1], posB[3 * cj + 2], strength };
+            out.push_back(e);
+            stats.drawn++;
+        }
+    }
+}
@@ -0,0 +1,213 @@
+// crowd.h
+// Stadium crowd for People Fighting. Spectators sit in rows behind the
+// horizon; rows further back are smaller, as if seen in perspective, and hold
+// more seats. Each one is kept as structure-of-arrays (seat position, size,
+// hop phase, reaction lag, shirt color, excitement) and animated every frame
+// by one SSE pass: excitement ramps up from 0 once the fight starts (after
+// each spectator's own lag), and excited spectators hop and sway in time with
+// their phase. Nothing carries over between frames, so any tick can be shown
+// directly, like the rest of the fight timeline.
+//
+// Drawing is instanced (render_batch.h): one template per level of detail and
+// shirt color, with the spectators stored color by color, row by row, so every
+// (color, detail) pair is one contiguous range and one instanced draw. The
+// detail follows the size of a head on screen: a round head and body up
+// close, a square head and body further back, and a single flat quad filling
+// the seat where a head is smaller than a pixel.
+//
+// Options: --crowd N (spectators, default 19: one row, as the original scene)
+#pragma once
+
+#include "circle_cache.h"
+#include "render_batch.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+enum CrowdDetail { CROWD_FULL, CROWD_SIMPLE, CROWD_IMPOSTOR, CROWD_DETAILS };
+
+const int CROWD_COLORS = 6;
+const float CROWD_SHIRTS[CROWD_COLORS][3] = {
+    { 0.8f, 0.1f, 0.1f }, { 0.1f, 0.2f, 0.8f }, { 0.9f, 0.8f, 0.1f },
+    { 0.1f, 0.6f, 0.2f }, { 0.95f, 0.95f, 0.95f }, { 0.9f, 0.5f, 0.1f },
+};
+const float CROWD_FRONT_Y = -0.1f;      // first row, on the horizon
+const float CROWD_LEFT = -0.9f, CROWD_RIGHT = 0.9f;
+const float CROWD_STANDS_HEIGHT = 0.65f; // rows are spaced to fill about this much
+const float CROWD_DEPTH = 0.004f;       // each row back is this much further away
+const float CROWD_HOP_RATE = 0.08f;     // hops per tick
+const float CROWD_HOP_HEIGHT = 0.2f;    // of a seat
+const float CROWD_SWAY = 0.25f;         // lean at the ends of a hop
+const float CROWD_RISE_TICKS = 20.0f;   // calm to fully excited
+const float CROWD_MAX_LAG = 30.0f;      // ticks before the slowest spectator reacts
+const float CROWD_FULL_PIXELS = 3.0f;   // head radius on screen for the full detail
+const float CROWD_SIMPLE_PIXELS = 1.0f; // ... and for the square heads
+
+struct Crowd {
+    int count = 19;             // --crowd
+    int padded = 0;             // arrays are padded to a multiple of 4 with still spectators
+    // seats, stored by shirt color and then from the front row back
+    std::vector<float> x, baseY, scale, phase, lag;
+    std::vector<unsigned char> color;
+    int colorStart[CROWD_COLORS + 1] = {};
+    // animated every frame
+    std::vector<float> y, dirX, dirY, excitement;
+    bool moving = false;        // anyone excited in the last update
+    BatchMesh meshes[CROWD_DETAILS][CROWD_COLORS];
+    // statistics
+    long long updates = 0;
+    double updateMs = 0;
+    int drawn[CROWD_DETAILS] = {}; // last frame
+    int draws = 0;              // last frame
+};
+
+inline bool crowdParseArg(int argc, char** argv, int& i, Crowd& c) {
+    if (strcmp(argv[i], "--crowd") == 0 && i + 1 < argc) { c.count = atoi(argv[++i]); return true; }
+    return false;
+}
+
+// Templates in seat units: the head (radius 0.2) is centred on the instance
+// position, the body hangs below it
+inline void crowdBuildMeshes(Crowd& c) {
+    for (int k = 0; k < CROWD_COLORS; ++k) {
+        const float* shirt = CROWD_SHIRTS[k];
+        for (int d = 0; d < CROWD_DETAILS; ++d) {
+            batchMeshBegin(c.meshes[d][k]);
+            // the impostor fills its whole seat, so a far crowd reads as a mosaic without gaps
+            float halfW = d == CROWD_IMPOSTOR ? 0.5f : 0.15f, top = d == CROWD_IMPOSTOR ? 0.4f : -0.2f;
+            batchColor3f(shirt[0], shirt[1], shirt[2]);
+            batchBegin(GL_QUADS);
+            batchVertex2f(-halfW, top);
+            batchVertex2f(-halfW, -0.6f);
+            batchVertex2f(halfW, -0.6f);
+            batchVertex2f(halfW, top);
+            batchEnd();
+            batchColor3f(0.2f, 0.2f, 0.2f);
+            if (d == CROWD_FULL) drawEllipse(GL_POLYGON, 0, 0, 0.2f, 0.2f, 16);
+            else if (d == CROWD_SIMPLE) {
+                batchBegin(GL_QUADS);
+                batchVertex2f(-0.18f, -0.18f);
+                batchVertex2f(0.18f, -0.18f);
+                batchVertex2f(0.18f, 0.18f);
+                batchVertex2f(-0.18f, 0.18f);
+                batchEnd();
+            }
+            batchMeshEnd(c.meshes[d][k]);
+        }
+    }
+}
+
+// Seat c.count spectators and record the templates (call once GL is up). The
+// seat pitch is chosen so the front row spacing matches the original scene for
+// a single row and the stands stay about CROWD_STANDS_HEIGHT tall for big crowds.
+inline void crowdInit(Crowd& c) {
+    if (c.count < 0) c.count = 0;
+    float width = CROWD_RIGHT - CROWD_LEFT;
+    float pitch = std::min(0.1f, sqrtf(width * CROWD_STANDS_HEIGHT / std::max(1, c.count)));
+    unsigned seed = 12345; // the same crowd every run
+    auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+
+    struct Seat { float x, y, scale, phase, lag; unsigned char color; };
+    std::vector<Seat> seats;
+    seats.reserve(c.count);
+    float rowY = CROWD_FRONT_Y;
+    for (int row = 0; (int)seats.size() < c.count; ++row) {
+        float s = pitch / (1.0f + CROWD_DEPTH * row);
+        int n = std::min(c.count - (int)seats.size(), (int)(width / s + 1e-3f) + 1);
+        for (int i = 0; i < n; ++i) {
+            Seat seat = { CROWD_LEFT + i * s, rowY, s, random(), random() * CROWD_MAX_LAG,
+                (unsigned char)(random() * CROWD_COLORS) };
+            seats.push_back(seat);
+        }
+        rowY += s;
+    }
+    // by color, keeping the row order within each (a stable counting sort)
+    int counts[CROWD_COLORS] = {};
+    for (const Seat& s : seats) counts[s.color]++;
+    c.colorStart[0] = 0;
+    for (int k = 0; k < CROWD_COLORS; ++k) c.colorStart[k + 1] = c.colorStart[k] + counts[k];
+    c.padded = (c.count + 3) / 4 * 4;
+    for (std::vector<float>* a : { &c.x, &c.baseY, &c.scale, &c.phase, &c.lag, &c.y, &c.dirX, &c.dirY, &c.excitement })
+        a->assign(c.padded, 0.0f);
+    c.color.assign(c.padded, 0);
+    int next[CROWD_COLORS];
+    std::copy(c.colorStart, c.colorStart + CROWD_COLORS, next);
+    for (const Seat& s : seats) {
+        int i = next[s.color]++;
+        c.x[i] = s.x;
+        c.baseY[i] = c.y[i] = s.y;
+        c.scale[i] = s.scale;
+        c.phase[i] = s.phase;
+        c.lag[i] = s.lag;
+        c.color[i] = s.color;
+    }
+    std::fill(c.dirX.begin(), c.dirX.end(), 1.0f); // upright; sway is added as dirY
+    crowdBuildMeshes(c);
+}
+
+// Pose every spectator for `tick`; the fight started at fightTick (a later
+// tick, or none yet, leaves everyone calm)
+inline void crowdUpdate(Crowd& c, float tick, float fightTick) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), four = _mm_set1_ps(4.0f);
+    const __m128 since = _mm_set1_ps(tick - fightTick), invRise = _mm_set1_ps(1.0f / CROWD_RISE_TICKS);
+    const __m128 hopT = _mm_set1_ps(tick * CROWD_HOP_RATE), height = _mm_set1_ps(CROWD_HOP_HEIGHT);
+    const __m128 sway = _mm_set1_ps(CROWD_SWAY);
+    __m128 any = zero;
+    for (int i = 0; i < c.padded; i += 4) {
+        __m128 e = _mm_mul_ps(_mm_sub_ps(since, _mm_loadu_ps(&c.lag[i])), invRise);
+        e = _mm_min_ps(one, _mm_max_ps(zero, e));
+        // position in the hop cycle, 0..1 (ticks are never negative)
+        __m128 u = _mm_add_ps(_mm_loadu_ps(&c.phase[i]), hopT);
+        __m128 s = _mm_sub_ps(u, _mm_cvtepi32_ps(_mm_cvttps_epi32(u)));
+        __m128 hop = _mm_mul_ps(_mm_mul_ps(four, s), _mm_sub_ps(one, s)); // parabola, 0 at the ends, 1 half way
+        __m128 lift = _mm_mul_ps(_mm_mul_ps(e, hop), _mm_mul_ps(height, _mm_loadu_ps(&c.scale[i])));
+        _mm_storeu_ps(&c.y[i], _mm_add_ps(_mm_loadu_ps(&c.baseY[i]), lift));
+        _mm_storeu_ps(&c.dirY[i], _mm_mul_ps(_mm_mul_ps(e, sway), _mm_sub_ps(_mm_add_ps(s, s), one)));
+        _mm_storeu_ps(&c.excitement[i], e);
+        any = _mm_or_ps(any, _mm_cmpgt_ps(e, zero));
+    }
+    c.moving = _mm_movemask_ps(any) != 0;
+    c.updates++;
+    c.updateMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Queue the crowd as instanced draws, the detail picked per row from the head
+// size on screen
+inline void crowdDraw(Crowd& c) {
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    float pixelsPerUnit = 0.2f * viewport[3] / 2.0f; // head radius per seat unit, gluOrtho2D(-1, 1, -1, 1)
+    std::fill(c.drawn, c.drawn + CROWD_DETAILS, 0);
+    c.draws = 0;
+    for (int k = 0; k < CROWD_COLORS; ++k) {
+        const float* scale = c.scale.data();
+        int begin = c.colorStart[k], end = c.colorStart[k + 1];
+        // rows get smaller towards the back, so each detail is one range
+        int fullEnd = (int)(std::partition_point(scale + begin, scale + end,
+            [&](float s) { return s * pixelsPerUnit >= CROWD_FULL_PIXELS; }) - scale);
+        int simpleEnd = (int)(std::partition_point(scale + fullEnd, scale + end,
+            [&](float s) { return s * pixelsPerUnit >= CROWD_SIMPLE_PIXELS; }) - scale);
+        int bounds[CROWD_DETAILS + 1] = { begin, fullEnd, simpleEnd, end };
+        for (int d = 0; d < CROWD_DETAILS; ++d) {
+            int first = bounds[d], n = bounds[d + 1] - bounds[d];
+            if (n <= 0) continue;
+            batchDrawInstances(c.meshes[d][k], &c.x[first], &c.y[first], &c.scale[first], &c.dirX[first],
+                &c.dirY[first], n, 1.0f, true);
+            c.drawn[d] += n;
+            c.draws++;
+        }
+    }
+}
+
+inline void crowdPrintStats(const Crowd& c) {
+    if (c.updates == 0) return;
+    printf("crowd: %d spectators, %.3f ms/update; last frame %d full, %d simple, %d impostors in %d instanced draws\n",
+        c.count, c.updateMs / c.updates, c.drawn[CROWD_FULL], c.drawn[CROWD_SIMPLE], c.drawn[CROWD_IMPOSTOR],
+        c.draws);
+}
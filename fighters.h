@@ -0,0 +1,179 @@
+// fighters.h
+// The fighters of People Fighting, any number of them, as structure-of-arrays:
+// position, size, team, contact box and the opponent each one is fighting.
+// In the story there are two, the men placed by the keyframe timeline. A
+// battle (--battle N) lines up N fighters in two teams on either side of the
+// field and simulates them tick by tick: everyone walks at the other team,
+// the sweep-and-prune broad phase (sweep_prune.h) finds the contact boxes that
+// overlap, and each opposing pair in contact stops and fights, swaying like
+// the two men, with a shout over the pair when it starts.
+//
+// Battles are drawn instanced, one template per team, so fighters are stored
+// team by team.
+#pragma once
+
+#include "circle_cache.h"
+#include "render_batch.h"
+#include "sweep_prune.h"
+#include "text_atlas.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+const float FIGHTER_TEAMS[2][3] = { { 0, 0, 1 }, { 1, 0, 0 } }; // blue, red
+// Box around a man at scale 1, from his head centre: half as wide as the
+// story's contact distance (0.15), from the top of the head to the feet
+const float FIGHTER_HALF_WIDTH = 0.075f, FIGHTER_TOP = 0.05f, FIGHTER_BOTTOM = -0.35f;
+const float BATTLE_WALK = 0.004f;       // per tick, varied by +-25% per fighter
+const float BATTLE_SWAY = 0.015f;       // amplitude at scale 1
+const float BATTLE_SWAY_RATE = 0.2f;    // radians per tick, as the men's sway
+const int BATTLE_SHOUT_TICKS = 40;      // a shout stays up this long
+const int BATTLE_MAX_SHOUTS = 6;        // newest shouts drawn
+const char* const BATTLE_SHOUTS[] = { "You stole my idea!", "It was mine first!", "Take that!", "Fight! Fight!" };
+
+struct BattleShout {
+    int a, b;                   // the pair
+    int tick, line;
+};
+
+struct Fighters {
+    int count = 0;
+    std::vector<float> x, y, scale;
+    std::vector<unsigned char> team;
+    std::vector<float> minX, maxX, minY, maxY; // contact boxes
+    // battle
+    std::vector<float> startX, speed;  // signed walk per tick
+    std::vector<float> dirX, dirY;     // facing, for the instanced draw
+    std::vector<int> partner;          // opponent being fought, -1 while walking
+    std::vector<int> engagedAt;
+    std::vector<float> stopX;
+    int tick = 0, fighting = 0;
+    float firstContact = 1e9f;         // tick of the first fight
+    int teamStart[3] = {};
+    std::vector<BattleShout> shouts;
+    SweepAndPrune sweep;
+    BatchMesh meshes[2];
+};
+
+inline int fighterAdd(Fighters& f, float x, float y, int team, float scale) {
+    f.x.push_back(x);
+    f.y.push_back(y);
+    f.scale.push_back(scale);
+    f.team.push_back((unsigned char)team);
+    for (std::vector<float>* a : { &f.minX, &f.maxX, &f.minY, &f.maxY }) a->push_back(0.0f);
+    return f.count++;
+}
+
+inline void fighterUpdateBoxes(Fighters& f) {
+    for (int i = 0; i < f.count; ++i) {
+        float s = f.scale[i];
+        f.minX[i] = f.x[i] - FIGHTER_HALF_WIDTH * s;
+        f.maxX[i] = f.x[i] + FIGHTER_HALF_WIDTH * s;
+        f.minY[i] = f.y[i] + FIGHTER_BOTTOM * s;
+        f.maxY[i] = f.y[i] + FIGHTER_TOP * s;
+    }
+}
+
+// ---------------- Battle ----------------
+// Back to the line-up before the first step
+inline void battleReset(Fighters& f) {
+    f.x = f.startX;
+    std::fill(f.partner.begin(), f.partner.end(), -1);
+    f.tick = 0;
+    f.fighting = 0;
+    f.firstContact = 1e9f;
+    f.shouts.clear();
+}
+
+// A stick man like the story's, with a coarser head, as one template per team
+inline void battleBuildMeshes(Fighters& f) {
+    for (int t = 0; t < 2; ++t) {
+        batchMeshBegin(f.meshes[t]);
+        batchColor3f(1.0f, 0.8f, 0.6f);
+        drawEllipse(GL_POLYGON, 0, 0, 0.05f, 0.05f, 12);
+        batchColor3f(FIGHTER_TEAMS[t][0], FIGHTER_TEAMS[t][1], FIGHTER_TEAMS[t][2]);
+        batchBegin(GL_LINES);
+        const float body[] = { 0, -0.05f, 0, -0.25f, 0, -0.1f, -0.1f, -0.15f, 0, -0.1f, 0.1f, -0.15f,
+            0, -0.25f, -0.08f, -0.35f, 0, -0.25f, 0.08f, -0.35f };
+        for (int i = 0; i < 20; i += 2) batchVertex2f(body[i], body[i + 1]);
+        batchEnd();
+        batchMeshEnd(f.meshes[t]);
+    }
+}
+
+// n fighters, half a team each, scattered over their half of the field and
+// sized so the field holds them
+inline void battleInit(Fighters& f, int n) {
+    f = Fighters();
+    float s = std::min(1.0f, 0.5f / sqrtf((float)std::max(1, n)));
+    unsigned seed = 4321; // the same battle every run
+    auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+    for (int t = 0; t < 2; ++t) {
+        f.teamStart[t] = f.count;
+        int members = t == 0 ? (n + 1) / 2 : n / 2;
+        float side = t == 0 ? -1.0f : 1.0f;
+        for (int i = 0; i < members; ++i) {
+            float x = side * (0.95f - 0.55f * random());
+            float y = -0.15f - 0.75f * random();
+            fighterAdd(f, x, y, t, s);
+            f.speed.push_back(-side * BATTLE_WALK * (0.75f + 0.5f * random()));
+            f.dirX.push_back(-side);
+        }
+    }
+    f.teamStart[2] = f.count;
+    f.startX = f.x;
+    f.dirY.assign(f.count, 0.0f);
+    f.partner.assign(f.count, -1);
+    f.engagedAt.assign(f.count, 0);
+    f.stopX.assign(f.count, 0.0f);
+    battleBuildMeshes(f);
+}
+
+// One tick: walk or sway, then find the contacts and start the new fights
+inline void battleStep(Fighters& f) {
+    f.tick++;
+    for (int i = 0; i < f.count; ++i) {
+        if (f.partner[i] < 0) {
+            float x = f.x[i] + f.speed[i];
+            if (x > -1.0f && x < 1.0f) f.x[i] = x; // nobody left to meet: wait at the far edge
+        }
+        else
+            f.x[i] = f.stopX[i] + f.dirX[i] * BATTLE_SWAY * f.scale[i] * sinf(BATTLE_SWAY_RATE * (f.tick - f.engagedAt[i]));
+    }
+    fighterUpdateBoxes(f);
+    sweepUpdate(f.sweep, f.minX.data(), f.maxX.data(), f.minY.data(), f.maxY.data(), f.count);
+
+    for (const SweepPair& p : f.sweep.pairs) {
+        if (f.team[p.a] == f.team[p.b]) continue;
+        bool fresh = f.partner[p.a] < 0 && f.partner[p.b] < 0;
+        for (int i : { p.a, p.b })
+            if (f.partner[i] < 0) {
+                f.partner[i] = i == p.a ? p.b : p.a;
+                f.engagedAt[i] = f.tick;
+                f.stopX[i] = f.x[i];
+                f.fighting++;
+            }
+        if (fresh) {
+            f.shouts.push_back({ p.a, p.b, f.tick, (p.a + p.b) % 4 });
+            f.firstContact = std::min(f.firstContact, (float)f.tick);
+        }
+    }
+    size_t old = 0;
+    while (old < f.shouts.size() && f.tick - f.shouts[old].tick >= BATTLE_SHOUT_TICKS) old++;
+    f.shouts.erase(f.shouts.begin(), f.shouts.begin() + old);
+}
+
+// Both teams as one instanced layer each, then the newest shouts above their pairs
+inline void battleDraw(Fighters& f) {
+    for (int t = 0; t < 2; ++t) {
+        int first = f.teamStart[t], n = f.teamStart[t + 1] - first;
+        batchDrawInstances(f.meshes[t], &f.x[first], &f.y[first], &f.scale[first], &f.dirX[first], &f.dirY[first], n,
+            1.0f, true);
+    }
+    size_t begin = f.shouts.size() > (size_t)BATTLE_MAX_SHOUTS ? f.shouts.size() - BATTLE_MAX_SHOUTS : 0;
+    for (size_t i = begin; i < f.shouts.size(); ++i) {
+        const BattleShout& s = f.shouts[i];
+        float x = std::min(f.x[s.a], f.x[s.b]), y = std::max(f.maxY[s.a], f.maxY[s.b]) + 0.02f;
+        textDraw(BATTLE_SHOUTS[s.line], x, y, batchNextLayerZ(), 0, 0, 0);
+    }
+}
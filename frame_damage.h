@@ -0,0 +1,43 @@
+// frame_damage.h
+// Redraw only when the picture would change. Each program sums up what its
+// frame shows as a few numbers (scene, animation tick, positions of the moving
+// things, HUD on/off...) and passes them to damageCheck() on every timer tick;
+// glutPostRedisplay() is only called when they differ from the ones of the
+// last frame drawn. A paused or settled scene then costs no rendering at all.
+//
+// The whole frame is redrawn when anything changed. Drawing only a damaged
+// rectangle would need the previous frame kept in the back buffer, which GLUT
+// doesn't promise after a swap, and copying it back each frame costs about as
+// much as redrawing these scenes on llvmpipe (see layer_cache.h).
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+struct FrameDamage {
+    std::vector<unsigned char> shown; // visible state of the last frame drawn
+    long long redraws = 0, skipped = 0;
+};
+
+inline FrameDamage frameDamage;
+
+// True when `state` (a plain array or padding-free struct, compared bytewise)
+// differs from the last frame drawn; it is then taken as drawn, so call it
+// when the redraw is about to be requested.
+inline bool damageCheck(const void* state, size_t size) {
+    FrameDamage& d = frameDamage;
+    if (d.shown.size() == size && memcmp(d.shown.data(), state, size) == 0) {
+        d.skipped++;
+        return false;
+    }
+    d.shown.assign((const unsigned char*)state, (const unsigned char*)state + size);
+    d.redraws++;
+    return true;
+}
+
+inline void damagePrintStats() {
+    long long total = frameDamage.redraws + frameDamage.skipped;
+    if (total == 0) return;
+    printf("damage: %lld of %lld frames changed, %lld unchanged\n", frameDamage.redraws, total, frameDamage.skipped);
+}
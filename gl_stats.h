@@ -0,0 +1,194 @@
+// gl_stats.h
+// Per-frame instrumentation of the GL work a program submits. The GL entry
+// points the programs and the shared headers use are redirected by macros to
+// thin wrappers that count draw calls, vertices and state changes before
+// calling through. Frames are bracketed by glStatsBeginFrame/EndFrame and the
+// scene-building part by glStatsSceneBegin/End for CPU timing.
+//
+// The last frame's numbers can be shown as a HUD (toggled with H in the
+// programs, or --hud) and every frame can be appended to a CSV file
+// (--stats-csv FILE).
+//
+// Include after headless.h and before the other shared headers so their GL
+// calls are counted too. Define GL_STATS_DISABLE to compile the macros out.
+#pragma once
+
+#include <GL/glut.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+struct GlFrameStats {
+    int drawCalls = 0;      // glBegin/glEnd blocks, glDrawArrays*, blits, bitmaps, GLUT spheres
+    long long vertices = 0; // vertices those draws submitted
+    int stateChanges = 0;   // color, matrix, program, texture, buffer and enable changes
+    int primitives = 0;     // shapes the scene built through the frame batch
+    double sceneMs = 0;     // CPU time building the scene
+    double frameMs = 0;     // CPU time for the whole display()
+};
+
+struct GlStats {
+    typedef std::chrono::steady_clock Clock;
+    GlFrameStats frame;     // being counted
+    GlFrameStats last;      // last finished frame (what the HUD shows)
+    bool hud = false;
+    FILE* csv = nullptr;
+    long long frameIndex = 0;
+    long long totalVertices = 0; // over all finished frames
+    Clock::time_point frameStart, sceneStart;
+};
+
+inline GlStats glStats;
+
+// ---------------- Wrappers ----------------
+inline void glStatsBegin(GLenum mode) { glStats.frame.drawCalls++; glBegin(mode); }
+inline void glStatsEnd() { glEnd(); }
+inline void glStatsVertex2f(GLfloat x, GLfloat y) { glStats.frame.vertices++; glVertex2f(x, y); }
+inline void glStatsVertex3f(GLfloat x, GLfloat y, GLfloat z) { glStats.frame.vertices++; glVertex3f(x, y, z); }
+inline void glStatsColor3f(GLfloat r, GLfloat g, GLfloat b) { glStats.frame.stateChanges++; glColor3f(r, g, b); }
+inline void glStatsColor4f(GLfloat r, GLfloat g, GLfloat b, GLfloat a) { glStats.frame.stateChanges++; glColor4f(r, g, b, a); }
+inline void glStatsPushMatrix() { glStats.frame.stateChanges++; glPushMatrix(); }
+inline void glStatsPopMatrix() { glStats.frame.stateChanges++; glPopMatrix(); }
+inline void glStatsTranslatef(GLfloat x, GLfloat y, GLfloat z) { glStats.frame.stateChanges++; glTranslatef(x, y, z); }
+inline void glStatsRotatef(GLfloat a, GLfloat x, GLfloat y, GLfloat z) { glStats.frame.stateChanges++; glRotatef(a, x, y, z); }
+inline void glStatsUseProgram(GLuint p) { glStats.frame.stateChanges++; glUseProgram(p); }
+inline void glStatsBindTexture(GLenum t, GLuint id) { glStats.frame.stateChanges++; glBindTexture(t, id); }
+inline void glStatsBindBuffer(GLenum t, GLuint id) { glStats.frame.stateChanges++; glBindBuffer(t, id); }
+inline void glStatsEnable(GLenum cap) { glStats.frame.stateChanges++; glEnable(cap); }
+inline void glStatsDisable(GLenum cap) { glStats.frame.stateChanges++; glDisable(cap); }
+
+inline void glStatsDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    glStats.frame.drawCalls++;
+    glStats.frame.vertices += count;
+    glDrawArrays(mode, first, count);
+}
+
+inline void glStatsDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+    glStats.frame.drawCalls++;
+    glStats.frame.vertices += (long long)count * instances;
+    glDrawArraysInstanced(mode, first, count, instances);
+}
+
+inline void glStatsBlitFramebuffer(GLint sx0, GLint sy0, GLint sx1, GLint sy1, GLint dx0, GLint dy0, GLint dx1, GLint dy1,
+    GLbitfield mask, GLenum filter) {
+    glStats.frame.drawCalls++;
+    glBlitFramebuffer(sx0, sy0, sx1, sy1, dx0, dy0, dx1, dy1, mask, filter);
+}
+
+inline void glStatsBitmap(GLsizei w, GLsizei h, GLfloat xo, GLfloat yo, GLfloat xm, GLfloat ym, const GLubyte* bits) {
+    glStats.frame.drawCalls++;
+    glBitmap(w, h, xo, yo, xm, ym, bits);
+}
+
+inline void glStatsBitmapCharacter(void* font, int c) {
+    glStats.frame.drawCalls++;
+    glutBitmapCharacter(font, c);
+}
+
+inline void glStatsSolidSphere(GLdouble r, GLint slices, GLint stacks) {
+    glStats.frame.drawCalls++;
+    glStats.frame.vertices += 2LL * slices * stacks;
+    glutSolidSphere(r, slices, stacks);
+}
+
+inline void glStatsSphere(GLUquadric* q, GLdouble r, GLint slices, GLint stacks) {
+    glStats.frame.drawCalls++;
+    glStats.frame.vertices += 2LL * slices * stacks;
+    gluSphere(q, r, slices, stacks);
+}
+
+#ifndef GL_STATS_DISABLE
+#define glBegin(mode) glStatsBegin(mode)
+#define glEnd() glStatsEnd()
+#define glVertex2f(x, y) glStatsVertex2f(x, y)
+#define glVertex3f(x, y, z) glStatsVertex3f(x, y, z)
+#define glColor3f(r, g, b) glStatsColor3f(r, g, b)
+#define glColor4f(r, g, b, a) glStatsColor4f(r, g, b, a)
+#define glPushMatrix() glStatsPushMatrix()
+#define glPopMatrix() glStatsPopMatrix()
+#define glTranslatef(x, y, z) glStatsTranslatef(x, y, z)
+#define glRotatef(a, x, y, z) glStatsRotatef(a, x, y, z)
+#define glUseProgram(p) glStatsUseProgram(p)
+#define glBindTexture(t, id) glStatsBindTexture(t, id)
+#define glBindBuffer(t, id) glStatsBindBuffer(t, id)
+#define glEnable(cap) glStatsEnable(cap)
+#define glDisable(cap) glStatsDisable(cap)
+#define glDrawArrays(mode, first, count) glStatsDrawArrays(mode, first, count)
+#define glDrawArraysInstanced(mode, first, count, n) glStatsDrawArraysInstanced(mode, first, count, n)
+#define glBlitFramebuffer(sx0, sy0, sx1, sy1, dx0, dy0, dx1, dy1, mask, filter) \
+    glStatsBlitFramebuffer(sx0, sy0, sx1, sy1, dx0, dy0, dx1, dy1, mask, filter)
+#define glBitmap(w, h, xo, yo, xm, ym, bits) glStatsBitmap(w, h, xo, yo, xm, ym, bits)
+#define glutBitmapCharacter(font, c) glStatsBitmapCharacter(font, c)
+#define glutSolidSphere(r, slices, stacks) glStatsSolidSphere(r, slices, stacks)
+#define gluSphere(q, r, slices, stacks) glStatsSphere(q, r, slices, stacks)
+#endif
+
+// ---------------- Frames ----------------
+// Parse one stats option at argv[i] (--hud, --stats-csv FILE); same contract
+// as headlessParseArg()
+inline bool glStatsParseArg(int argc, char** argv, int& i) {
+    if (strcmp(argv[i], "--hud") == 0) { glStats.hud = true; return true; }
+    if (strcmp(argv[i], "--stats-csv") == 0 && i + 1 < argc) {
+        const char* path = argv[++i];
+        glStats.csv = fopen(path, "a");
+        if (!glStats.csv) { fprintf(stderr, "cannot open %s\n", path); exit(1); }
+        if (ftell(glStats.csv) == 0)
+            fprintf(glStats.csv, "frame,label,draw_calls,vertices,state_changes,primitives,scene_ms,frame_ms\n");
+        return true;
+    }
+    return false;
+}
+
+inline double glStatsMsSince(GlStats::Clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(GlStats::Clock::now() - t).count();
+}
+
+inline void glStatsBeginFrame() {
+    glStats.frame = GlFrameStats();
+    glStats.frameStart = GlStats::Clock::now();
+}
+
+inline void glStatsSceneBegin() {
+    glStats.sceneStart = GlStats::Clock::now();
+}
+
+inline void glStatsSceneEnd() {
+    glStats.frame.sceneMs += glStatsMsSince(glStats.sceneStart);
+}
+
+// Close the frame: `primitives` is what the scene built (batch.stats.primitives),
+// `label` names the scene in the CSV
+inline void glStatsEndFrame(const char* label, int primitives) {
+    glStats.frame.primitives = primitives;
+    glStats.frame.frameMs = glStatsMsSince(glStats.frameStart);
+    glStats.last = glStats.frame;
+    glStats.totalVertices += glStats.frame.vertices;
+    if (glStats.csv) {
+        const GlFrameStats& f = glStats.last;
+        fprintf(glStats.csv, "%lld,%s,%d,%lld,%d,%d,%.4f,%.4f\n", glStats.frameIndex, label,
+            f.drawCalls, f.vertices, f.stateChanges, f.primitives, f.sceneMs, f.frameMs);
+    }
+    glStats.frameIndex++;
+}
+
+inline void glStatsToggleHud() {
+    glStats.hud = !glStats.hud;
+}
+
+// HUD lines for the last finished frame in the bottom right of the viewport,
+// clear of the programs' titles and footers. Each line is handed to
+// drawLine(text, x, y) in window pixels so the program can use its own text path.
+inline void glStatsDrawHud(void (*drawLine)(const char*, float, float)) {
+    if (!glStats.hud) return;
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    const GlFrameStats& f = glStats.last;
+    char line[4][96];
+    snprintf(line[0], sizeof(line[0]), "frame %.2f ms (scene %.2f ms)", f.frameMs, f.sceneMs);
+    snprintf(line[1], sizeof(line[1]), "draw calls %d", f.drawCalls);
+    snprintf(line[2], sizeof(line[2]), "vertices %lld", f.vertices);
+    snprintf(line[3], sizeof(line[3]), "state changes %d, shapes %d", f.stateChanges, f.primitives);
+    for (int i = 0; i < 4; ++i) drawLine(line[i], (float)(viewport[2] - 260), (float)(40 + 22 * (3 - i)));
+}
@@ -0,0 +1,265 @@
+// headless.h
+// Offscreen render mode shared by the GLUT programs. Instead of opening a window,
+// an EGL surfaceless context is created on Mesa's software rasterizer (llvmpipe),
+// the program's simulation is stepped once per frame without the GLUT timer, and
+// frames can be dumped as PPM images.
+//
+// Usage: <program> --headless [--scene N] [--frames N] [--size WxH] [--out dir/]
+//                  [--bench-json FILE] [--warmup N] [--skip-unchanged] [--start TICK]
+//                  [--video FILE ...]
+//
+// --bench-json appends one JSON line with the run's frame-time distribution and
+// throughput (see headlessWriteBench), which bench/scene_bench.cpp collects;
+// the first --warmup frames are rendered but left out of it. --skip-unchanged
+// leaves out the redraw of frames the program reports as unchanged, as its
+// window does (the previous image stays in the pbuffer). --start begins the
+// run at an animation tick: programs that can jump there directly set
+// headless.seek, the others are stepped to it without rendering. --video
+// streams the frames to a video file or encoder (see video_export.h).
+#pragma once
+
+#include <GL/glut.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <sys/stat.h>
+#include "video_export.h"
+
+struct HeadlessOptions {
+    bool enabled = false;
+    int scene = 1;              // scene to render, 0 for all (storyboard program only)
+    int frames = 300;           // number of frames to step and render
+    int width = 800, height = 600;
+    const char* outDir = nullptr; // write frame_NNNNN.ppm here when set
+    const char* benchOut = nullptr; // append the run's timings as JSON here when set
+    int warmup = 0;             // leading frames left out of the bench numbers
+    bool skipUnchanged = false; // don't redraw frames the program reports unchanged
+    int start = 0;              // animation tick of the first frame
+    void (*seek)(int tick) = nullptr; // jump straight to a tick, if the program can
+    const long long* vertexCounter = nullptr; // running count of vertices sent to GL, if the program keeps one
+    // Software backend (soft_raster.h): finishes the frame in presentFrame()
+    // and supplies its pixels; the GL surface is then only a 1x1 stub
+    void (*present)() = nullptr;
+    void (*readPixels)(unsigned char* pixels, GLenum format) = nullptr;
+};
+
+inline HeadlessOptions headless;
+
+// Per-frame timings of the last headlessRun()
+struct HeadlessTimings {
+    std::vector<double> stepMs, drawMs;
+    std::vector<long long> vertices; // from headless.vertexCounter
+    double totalMs = 0;
+};
+
+inline HeadlessTimings headlessTimings;
+
+// Parse one headless option at argv[i]. Returns true (and advances i past any
+// value) when the option was recognised, so programs can add their own options.
+inline bool headlessParseArg(int argc, char** argv, int& i) {
+    const char* a = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (strcmp(a, "--headless") == 0) { headless.enabled = true; return true; }
+    if (strcmp(a, "--scene") == 0 && hasValue) { // "all": the whole storyboard
+        const char* v = argv[++i];
+        char* end = nullptr;
+        long n = strtol(v, &end, 10);
+        if (strcmp(v, "all") == 0) headless.scene = 0;
+        else if (end != v && *end == '\0' && n >= 1 && n <= INT_MAX) headless.scene = (int)n;
+        else {
+            fprintf(stderr, "--scene expects a scene number from 1 or \"all\", not \"%s\"\n", v);
+            exit(1);
+        }
+        return true;
+    }
+    if (strcmp(a, "--frames") == 0 && hasValue) { headless.frames = atoi(argv[++i]); return true; }
+    if (strcmp(a, "--out") == 0 && hasValue) { headless.outDir = argv[++i]; return true; }
+    if (strcmp(a, "--bench-json") == 0 && hasValue) { headless.benchOut = argv[++i]; return true; }
+    if (strcmp(a, "--warmup") == 0 && hasValue) { headless.warmup = atoi(argv[++i]); return true; }
+    if (strcmp(a, "--skip-unchanged") == 0) { headless.skipUnchanged = true; return true; }
+    if (strcmp(a, "--start") == 0 && hasValue) { headless.start = atoi(argv[++i]); return true; }
+    if (strcmp(a, "--size") == 0 && hasValue) {
+        if (sscanf(argv[++i], "%dx%d", &headless.width, &headless.height) != 2) {
+            fprintf(stderr, "--size expects WxH, e.g. 1280x720\n");
+            exit(1);
+        }
+        return true;
+    }
+    return videoParseArg(argc, argv, i);
+}
+
+// Create the offscreen context and make it current. The pbuffer has a depth
+// buffer so 3D programs work unchanged.
+inline bool headlessInitContext() {
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0); // software path even on GPU boxes
+
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    EGLDisplay dpy = getPlatformDisplay
+        ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)
+        : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major, minor;
+    if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor)) {
+        fprintf(stderr, "headless: cannot initialise EGL\n");
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_API);
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(dpy, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        fprintf(stderr, "headless: no pbuffer config\n");
+        return false;
+    }
+    int surfaceW = headless.present ? 1 : headless.width, surfaceH = headless.present ? 1 : headless.height;
+    const EGLint surfaceAttribs[] = { EGL_WIDTH, surfaceW, EGL_HEIGHT, surfaceH, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(dpy, config, surfaceAttribs);
+    EGLContext ctx = eglCreateContext(dpy, config, EGL_NO_CONTEXT, nullptr);
+    if (surface == EGL_NO_SURFACE || ctx == EGL_NO_CONTEXT || !eglMakeCurrent(dpy, surface, surface, ctx)) {
+        fprintf(stderr, "headless: cannot create offscreen context\n");
+        return false;
+    }
+    glViewport(0, 0, headless.width, headless.height);
+    printf("headless: %dx%d on %s\n", headless.width, headless.height, (const char*)glGetString(GL_RENDERER));
+    return true;
+}
+
+// End-of-frame call for display(): swaps in a window; offscreen it only
+// finishes the frame of a software backend, if one is set
+inline void presentFrame() {
+    if (!headless.enabled) glutSwapBuffers();
+    else if (headless.present) headless.present();
+}
+
+// Read back the current frame as bottom-up rows of GL_RGB or GL_RGBA pixels
+inline void headlessReadPixels(unsigned char* pixels, GLenum format = GL_RGB) {
+    if (headless.readPixels) {
+        headless.readPixels(pixels, format);
+        return;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, headless.width, headless.height, format, GL_UNSIGNED_BYTE, pixels);
+}
+
+// Read back the current frame and write it as a binary PPM
+inline void headlessWriteFrame(int frame) {
+    int w = headless.width, h = headless.height;
+    static std::vector<unsigned char> pixels;
+    pixels.resize((size_t)w * h * 3);
+    headlessReadPixels(pixels.data());
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/frame_%05d.ppm", headless.outDir, frame);
+    FILE* f = fopen(path, "wb");
+    if (!f) { fprintf(stderr, "headless: cannot write %s\n", path); return; }
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    for (int y = h - 1; y >= 0; --y) // GL rows are bottom-up
+        fwrite(&pixels[(size_t)y * w * 3], 1, (size_t)w * 3, f);
+    fclose(f);
+}
+
+// Step and render headless.frames frames as fast as possible, then report
+// throughput. `changed`, when given, is asked after each step whether the
+// frame differs from the last one drawn (see frame_damage.h).
+inline void headlessRun(void (*step)(), void (*draw)(), bool (*changed)() = nullptr) {
+    typedef std::chrono::steady_clock Clock;
+    if (headless.outDir) mkdir(headless.outDir, 0755);
+    if (video.path && !videoOpen(headless.width, headless.height)) exit(1);
+    if (headless.start > 0) { // not timed: only the frames rendered count
+        Clock::time_point s0 = Clock::now();
+        if (headless.seek) headless.seek(headless.start);
+        else for (int i = 0; i < headless.start; ++i) step();
+        printf("headless: %s to tick %d in %.3f ms\n", headless.seek ? "seeked" : "stepped",
+            headless.start, std::chrono::duration<double, std::milli>(Clock::now() - s0).count());
+    }
+
+    double stepMs = 0, drawMs = 0;
+    HeadlessTimings& t = headlessTimings;
+    t.stepMs.clear();
+    t.drawMs.clear();
+    t.vertices.clear();
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < headless.frames; ++frame) {
+        Clock::time_point t0 = Clock::now();
+        step();
+        Clock::time_point t1 = Clock::now();
+        bool redraw = !changed || changed() || !headless.skipUnchanged;
+        if (redraw) {
+            draw();
+            glFinish();
+        }
+        if (video.path) { // queued for the writer thread; an unchanged frame is repeated without a read-back
+            unsigned char* pixels;
+            int buffer = VIDEO_REPEAT;
+            if (redraw || frame == 0) {
+                buffer = videoAcquire(&pixels);
+                headlessReadPixels(pixels, GL_RGBA); // llvmpipe reads RGBA about twice as fast as RGB
+            }
+            videoSubmit(buffer);
+        }
+        Clock::time_point t2 = Clock::now();
+        t.stepMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        t.drawMs.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+        stepMs += t.stepMs.back();
+        drawMs += t.drawMs.back();
+        if (headless.vertexCounter) t.vertices.push_back(*headless.vertexCounter);
+        if (headless.outDir) headlessWriteFrame(frame);
+    }
+    double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    t.totalMs = totalMs;
+    if (video.path) videoClose();
+
+    int n = headless.frames > 0 ? headless.frames : 1;
+    printf("headless: %d frames in %.1f ms (%.1f frames/sec), step %.3f ms/frame, render %.3f ms/frame\n",
+        headless.frames, totalMs, headless.frames * 1000.0 / (totalMs > 0 ? totalMs : 1),
+        stepMs / n, drawMs / n);
+}
+
+// Value below which fraction q of the sorted samples fall (nearest rank)
+inline double headlessPercentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t rank = (size_t)(q * sorted.size() + 0.999999);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+// Append the last run's numbers to --bench-json as one JSON object per line:
+// median and p99 frame time (step + render), vertices/sec over the render time
+// and simulation steps/sec (vertices only when headless.vertexCounter is set).
+inline void headlessWriteBench() {
+    if (!headless.benchOut) return;
+    const HeadlessTimings& t = headlessTimings;
+    size_t first = headless.warmup > 0 ? (size_t)headless.warmup : 0;
+    if (first >= t.stepMs.size()) first = 0; // too short to drop anything
+    std::vector<double> frameMs;
+    double stepMs = 0, drawMs = 0;
+    for (size_t i = first; i < t.stepMs.size(); ++i) {
+        frameMs.push_back(t.stepMs[i] + t.drawMs[i]);
+        stepMs += t.stepMs[i];
+        drawMs += t.drawMs[i];
+    }
+    long long vertices = 0;
+    if (!t.vertices.empty()) vertices = t.vertices.back() - (first > 0 ? t.vertices[first - 1] : 0);
+    std::sort(frameMs.begin(), frameMs.end());
+    FILE* f = fopen(headless.benchOut, "a");
+    if (!f) { fprintf(stderr, "headless: cannot write %s\n", headless.benchOut); return; }
+    fprintf(f, "{\"frames\": %d, \"width\": %d, \"height\": %d, \"median_ms\": %.4f, \"p99_ms\": %.4f, "
+        "\"vertices_per_sec\": %.0f, \"steps_per_sec\": %.1f, \"total_ms\": %.1f}\n",
+        (int)frameMs.size(), headless.width, headless.height,
+        headlessPercentile(frameMs, 0.5), headlessPercentile(frameMs, 0.99),
+        drawMs > 0 ? vertices * 1000.0 / drawMs : 0.0,
+        stepMs > 0 ? frameMs.size() * 1000.0 / stepMs : 0.0, t.totalMs);
+    fclose(f);
+}
@@ -0,0 +1,104 @@
+// keyframe_timeline.h
+// Keyframed animation. Every animated property is a track of keys sorted by
+// time; its value at any time is found by a binary search for the two keys
+// around it and an interpolation between them. Nothing is integrated from
+// frame to frame, so any tick can be shown directly: scrubbing back and
+// forth, headless runs starting at --start and replays all cost the same as
+// the next frame.
+//
+// A timeline keeps the keys of all its tracks in flat arrays (times, values,
+// interpolation of the segment each key starts) and evaluates every track for
+// one time in a single pass. Playback mostly moves forward within a segment or
+// into the next one, so each track remembers the segment of its last lookup
+// and only searches when the time jumped further.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+enum KeyInterp : unsigned char {
+    KEY_STEP,       // hold the key's value until the next key
+    KEY_LINEAR,
+    KEY_SMOOTH,     // cosine ease; SMOOTH keys on the turning points of a sine trace it exactly
+};
+
+struct KeyTrack {
+    int first = 0, count = 0;   // into the timeline's key arrays
+    float loopStart = -1;       // >= 0: past the last key, replay from here
+    int cursor = 0;             // segment of the last lookup
+};
+
+struct Timeline {
+    std::vector<float> times, values;
+    std::vector<KeyInterp> interps;
+    std::vector<KeyTrack> tracks;
+    long long cursorHits = 0, searches = 0;
+};
+
+// Start a new track; keys are added to it with timelineKey() until the next
+// one is started. Returns its index, the slot timelineEvaluate() fills.
+inline int timelineAddTrack(Timeline& tl, float loopStart = -1) {
+    KeyTrack k;
+    k.first = (int)tl.times.size();
+    k.loopStart = loopStart;
+    tl.tracks.push_back(k);
+    return (int)tl.tracks.size() - 1;
+}
+
+// Add a key to the last track. Keys may come in any order; they are kept
+// sorted (a key at the time of an existing one goes after it).
+inline void timelineKey(Timeline& tl, float time, float value, KeyInterp interp = KEY_LINEAR) {
+    KeyTrack& k = tl.tracks.back();
+    size_t end = (size_t)k.first + k.count;
+    size_t at = std::upper_bound(tl.times.begin() + k.first, tl.times.begin() + end, time) - tl.times.begin();
+    tl.times.insert(tl.times.begin() + at, time);
+    tl.values.insert(tl.values.begin() + at, value);
+    tl.interps.insert(tl.interps.begin() + at, interp);
+    k.count++;
+}
+
+// Value of one track at time t: the first key's value before it, the last
+// key's value after it (unless the track loops)
+inline float timelineTrackValue(Timeline& tl, int track, float t) {
+    KeyTrack& k = tl.tracks[track];
+    if (k.count == 0) return 0;
+    const float* times = &tl.times[k.first];
+    const float* values = &tl.values[k.first];
+    float last = times[k.count - 1];
+    if (t > last && k.loopStart >= 0 && k.loopStart < last)
+        t = k.loopStart + fmodf(t - k.loopStart, last - k.loopStart);
+    if (t <= times[0]) return values[0];
+    if (t >= last) return values[k.count - 1];
+
+    // segment i holds times[i] <= t < times[i + 1]
+    int i = k.cursor;
+    if (i + 1 < k.count && times[i] <= t && t < times[i + 1]) tl.cursorHits++;
+    else if (i + 2 < k.count && times[i + 1] <= t && t < times[i + 2]) { i++; tl.cursorHits++; }
+    else {
+        i = (int)(std::upper_bound(times, times + k.count, t) - times) - 1;
+        tl.searches++;
+    }
+    k.cursor = i;
+
+    float v0 = values[i], v1 = values[i + 1];
+    float s = (t - times[i]) / (times[i + 1] - times[i]);
+    switch (tl.interps[k.first + i]) {
+    case KEY_STEP: return v0;
+    case KEY_SMOOTH: s = 0.5f - 0.5f * cosf(3.14159265f * s); break;
+    default: break;
+    }
+    return v0 + (v1 - v0) * s;
+}
+
+// Values of all tracks at time t, out[track]
+inline void timelineEvaluate(Timeline& tl, float t, float* out) {
+    for (size_t i = 0; i < tl.tracks.size(); ++i)
+        out[i] = timelineTrackValue(tl, (int)i, t);
+}
+
+inline void timelinePrintStats(const char* name, const Timeline& tl) {
+    printf("timeline %s: %zu tracks, %zu keys, %lld lookups from the last segment, %lld binary searches\n",
+        name, tl.tracks.size(), tl.times.size(), tl.cursorHits, tl.searches);
+}
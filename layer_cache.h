@@ -0,0 +1,189 @@
+// layer_cache.h
+// Static scenery built once and reused. A scene wraps the layers that never
+// change (sky, buildings, ground...) in layerCacheBegin/End; the first frame
+// builds them through the batch as usual and keeps the result, later frames
+// put it back and skip the static drawing code entirely. The animated layers
+// are drawn on top as before.
+//
+// The result is kept in one of two forms, picked when it is built:
+//   - an image: the static layers are drawn right away and the viewport is
+//     copied into a framebuffer object, which later frames blit back. Used
+//     when the layers are heavy (many small triangles) and nothing was drawn
+//     underneath them; needs GL 3.0.
+//   - a compiled vertex buffer of the layers' finished vertices, drawn with one
+//     glDrawArrays per primitive type. The vertices keep their depth layers, so
+//     this works anywhere in the frame. Used for light layers, where on
+//     llvmpipe copying a full viewport back costs more than rasterizing them.
+//
+// The cache is keyed by the caller (e.g. the scene number), the viewport size
+// and the depth layer the static part starts at, so it is rebuilt on a scene
+// switch or a resize; layerCacheInvalidate() forces a rebuild when the static
+// content itself changes.
+#pragma once
+
+#include "render_batch.h"
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// An image pays off once the layers have about one vertex per this many
+// viewport pixels (llvmpipe: a 800x600 blit costs about as much as 2400
+// vertices of small filled shapes)
+const int LAYER_CACHE_PIXELS_PER_VERTEX = 200;
+
+struct LayerCacheList {
+    GLint first = 0;
+    GLsizei count = 0;
+};
+
+struct LayerCache {
+    GLuint fbo = 0, colorBuffer = 0; // image form
+    GLuint vbo = 0;                  // vertex buffer form
+    LayerCacheList tris, lines, points;
+    bool image = false;         // which form is cached
+    int key = -1;               // what is cached, -1 when nothing is
+    int width = 0, height = 0;  // viewport it was built for
+    int imageW = 0, imageH = 0; // size of the color buffer
+    int startLayer = 0;         // batch layer before the static part
+    int layers = 0;             // batch layers the static part used
+    bool recording = false;     // between a rebuilding layerCacheBegin and layerCacheEnd
+    bool bottom = false;        // nothing was batched underneath while recording
+    size_t mark[3] = {};        // batch list sizes when recording started
+    long long hits = 0, rebuilds = 0;
+};
+
+inline void layerCacheInvalidate(LayerCache& c) {
+    c.key = -1;
+}
+
+// Framebuffer objects and blits (GL 3.0), probed once
+inline bool layerCacheCanBlit() {
+    static int canBlit = -1;
+    if (canBlit < 0) {
+        int major = 0, minor = 0;
+        const char* version = (const char*)glGetString(GL_VERSION);
+        canBlit = version && sscanf(version, "%d.%d", &major, &minor) == 2 && major >= 3;
+    }
+    return canBlit == 1;
+}
+
+inline void layerCacheDrawList(const LayerCacheList& l, GLenum mode) {
+    if (l.count == 0) return;
+    glDrawArrays(mode, l.first, l.count);
+    batch.stats.vertices += l.count;
+    batch.stats.flushes++;
+}
+
+inline void layerCacheReplay(const LayerCache& c, const int* viewport) {
+    if (c.image) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, c.fbo);
+        glBlitFramebuffer(0, 0, c.width, c.height, viewport[0], viewport[1],
+            viewport[0] + c.width, viewport[1] + c.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        batch.stats.flushes++;
+        return;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, c.vbo);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(BatchVertex), (const void*)offsetof(BatchVertex, x));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(BatchVertex), (const void*)offsetof(BatchVertex, r));
+    layerCacheDrawList(c.tris, GL_TRIANGLES);
+    layerCacheDrawList(c.lines, GL_LINES);
+    layerCacheDrawList(c.points, GL_POINTS);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Start the static layers. Returns true when they have to be built (follow
+// with layerCacheEnd), false when the cached copy was drawn instead and they
+// must be skipped.
+inline bool layerCacheBegin(LayerCache& c, int key) {
+    if (batch.backend) return true; // nothing to replay into: a software backend draws everything
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    bool bottom = batch.layer == 0 && batch.tris.empty() && batch.lines.empty() && batch.points.empty() &&
+        batch.instanceDraws.empty();
+    if (c.key == key && c.startLayer == batch.layer && c.width == viewport[2] && c.height == viewport[3] &&
+        (!c.image || bottom)) {
+        layerCacheReplay(c, viewport);
+        // the animated layers continue where the static ones stopped, as if built
+        batch.layer = c.startLayer + c.layers;
+        batch.layerZ = -1.0f + batch.layer * BATCH_LAYER_STEP;
+        c.hits++;
+        return false;
+    }
+    c.key = key;
+    c.width = viewport[2];
+    c.height = viewport[3];
+    c.startLayer = batch.layer;
+    c.bottom = bottom;
+    c.mark[0] = batch.tris.size();
+    c.mark[1] = batch.lines.size();
+    c.mark[2] = batch.points.size();
+    c.recording = true;
+    return true;
+}
+
+// Copy the viewport, where the static layers have just been drawn, into the
+// cache's color buffer
+inline void layerCacheKeepImage(LayerCache& c) {
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    int x = viewport[0], y = viewport[1], w = viewport[2], h = viewport[3];
+    if (!c.fbo) {
+        glGenFramebuffers(1, &c.fbo);
+        glGenRenderbuffers(1, &c.colorBuffer);
+    }
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, c.fbo);
+    if (c.imageW != w || c.imageH != h) {
+        glBindRenderbuffer(GL_RENDERBUFFER, c.colorBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, c.colorBuffer);
+        c.imageW = w;
+        c.imageH = h;
+    }
+    glBlitFramebuffer(x, y, x + w, y + h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+}
+
+// Finish the static layers and keep them in the form that suits them
+inline void layerCacheEnd(LayerCache& c) {
+    if (!c.recording) return;
+    c.recording = false;
+    c.layers = batch.layer - c.startLayer;
+    c.rebuilds++;
+
+    std::vector<BatchVertex>* lists[3] = { &batch.tris, &batch.lines, &batch.points };
+    size_t count = 0;
+    for (int i = 0; i < 3; ++i) count += lists[i]->size() - c.mark[i];
+    c.image = c.bottom && layerCacheCanBlit() &&
+        (long long)count * LAYER_CACHE_PIXELS_PER_VERTEX >= (long long)c.width * c.height;
+    if (c.image) {
+        batchSubmit(); // only the static layers are queued
+        layerCacheKeepImage(c);
+        return;
+    }
+
+    // vertex buffer: this frame still draws the layers from the batch
+    LayerCacheList* ranges[3] = { &c.tris, &c.lines, &c.points };
+    std::vector<BatchVertex> vertices;
+    vertices.reserve(count);
+    for (int i = 0; i < 3; ++i) {
+        ranges[i]->first = (GLint)vertices.size();
+        ranges[i]->count = (GLsizei)(lists[i]->size() - c.mark[i]);
+        vertices.insert(vertices.end(), lists[i]->begin() + c.mark[i], lists[i]->end());
+    }
+    if (!c.vbo) glGenBuffers(1, &c.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, c.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(BatchVertex), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+inline void layerCachePrintStats(const char* name, const LayerCache& c) {
+    if (c.rebuilds == 0) return;
+    printf("layer cache %s: %s, built %lld times, reused %lld times\n", name,
+        c.image ? "image" : "vertex buffer", c.rebuilds, c.hits);
+}
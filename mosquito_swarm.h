@@ -0,0 +1,288 @@
+// mosquito_swarm.h
+// Mosquito swarm stored as structure-of-arrays with a branch-free update:
+// each agent moves by (dx, dy) and its velocity component is negated when it
+// leaves [-1, 1], done with compare masks and a sign-bit xor instead of ifs.
+// Scalar, SSE and AVX kernels exist; the fastest the CPU supports is chosen at
+// startup unless a path is forced by name.
+//
+// SwarmScheduler runs the update at a fixed rate on its own thread, split into
+// chunks over a ThreadPool, and publishes each finished step through a double
+// buffer so display() always has a complete snapshot without waiting.
+#pragma once
+
+#include "thread_pool.h"
+#include <immintrin.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Arrays are padded to a multiple of 8 with zero-velocity agents so the SIMD
+// loops never need a scalar tail.
+const int SWARM_PAD = 8;
+
+struct MosquitoSwarm {
+    int count = 0;      // live agents
+    int padded = 0;     // allocated length, multiple of SWARM_PAD
+    float* x = nullptr;
+    float* y = nullptr;
+    float* dx = nullptr;
+    float* dy = nullptr;
+    float* size = nullptr;
+};
+
+// Reads one state and writes the next; the output may alias the input
+typedef void (*SwarmKernel)(const float* x, const float* y, const float* dx, const float* dy,
+    float* ox, float* oy, float* odx, float* ody, int begin, int end);
+
+inline float* swarmAlloc(int n) {
+    float* p = (float*)aligned_alloc(32, n * sizeof(float));
+    memset(p, 0, n * sizeof(float));
+    return p;
+}
+
+inline void swarmFree(MosquitoSwarm& s) {
+    free(s.x); free(s.y); free(s.dx); free(s.dy); free(s.size);
+    s = MosquitoSwarm();
+}
+
+// Random positions in [-1, 1] and slow random directions (same draws as the
+// original AoS initialisation, so small swarms look the same)
+inline void swarmInit(MosquitoSwarm& s, int n) {
+    swarmFree(s);
+    s.count = n;
+    s.padded = (n + SWARM_PAD - 1) / SWARM_PAD * SWARM_PAD;
+    s.x = swarmAlloc(s.padded); s.y = swarmAlloc(s.padded);
+    s.dx = swarmAlloc(s.padded); s.dy = swarmAlloc(s.padded);
+    s.size = swarmAlloc(s.padded);
+    for (int i = 0; i < n; i++) {
+        s.x[i] = ((rand() % 200) / 100.0f) - 1.0f;
+        s.y[i] = ((rand() % 200) / 100.0f) - 1.0f;
+        s.dx[i] = ((rand() % 50) / 10000.0f) - 0.005f;
+        s.dy[i] = ((rand() % 50) / 10000.0f) - 0.005f;
+        s.size[i] = 0.05f;
+    }
+}
+
+// ---------------- Kernels ----------------
+inline void swarmUpdateScalar(const float* x, const float* y, const float* dx, const float* dy,
+    float* ox, float* oy, float* odx, float* ody, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        float px = x[i] + dx[i], py = y[i] + dy[i];
+        float vx = dx[i], vy = dy[i];
+        ox[i] = px;
+        oy[i] = py;
+        odx[i] = (px < -1.0f || px > 1.0f) ? -vx : vx;
+        ody[i] = (py < -1.0f || py > 1.0f) ? -vy : vy;
+    }
+}
+
+inline void swarmUpdateSSE(const float* x, const float* y, const float* dx, const float* dy,
+    float* ox, float* oy, float* odx, float* ody, int begin, int end) {
+    const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f), sign = _mm_set1_ps(-0.0f);
+    for (int i = begin; i < end; i += 4) {
+        __m128 vx = _mm_load_ps(dx + i), vy = _mm_load_ps(dy + i);
+        __m128 px = _mm_add_ps(_mm_load_ps(x + i), vx);
+        __m128 py = _mm_add_ps(_mm_load_ps(y + i), vy);
+        __m128 outX = _mm_or_ps(_mm_cmplt_ps(px, lo), _mm_cmpgt_ps(px, hi));
+        __m128 outY = _mm_or_ps(_mm_cmplt_ps(py, lo), _mm_cmpgt_ps(py, hi));
+        _mm_store_ps(ox + i, px);
+        _mm_store_ps(oy + i, py);
+        _mm_store_ps(odx + i, _mm_xor_ps(vx, _mm_and_ps(outX, sign)));
+        _mm_store_ps(ody + i, _mm_xor_ps(vy, _mm_and_ps(outY, sign)));
+    }
+}
+
+__attribute__((target("avx")))
+inline void swarmUpdateAVX(const float* x, const float* y, const float* dx, const float* dy,
+    float* ox, float* oy, float* odx, float* ody, int begin, int end) {
+    const __m256 lo = _mm256_set1_ps(-1.0f), hi = _mm256_set1_ps(1.0f), sign = _mm256_set1_ps(-0.0f);
+    for (int i = begin; i < end; i += 8) {
+        __m256 vx = _mm256_load_ps(dx + i), vy = _mm256_load_ps(dy + i);
+        __m256 px = _mm256_add_ps(_mm256_load_ps(x + i), vx);
+        __m256 py = _mm256_add_ps(_mm256_load_ps(y + i), vy);
+        __m256 outX = _mm256_or_ps(_mm256_cmp_ps(px, lo, _CMP_LT_OQ), _mm256_cmp_ps(px, hi, _CMP_GT_OQ));
+        __m256 outY = _mm256_or_ps(_mm256_cmp_ps(py, lo, _CMP_LT_OQ), _mm256_cmp_ps(py, hi, _CMP_GT_OQ));
+        _mm256_store_ps(ox + i, px);
+        _mm256_store_ps(oy + i, py);
+        _mm256_store_ps(odx + i, _mm256_xor_ps(vx, _mm256_and_ps(outX, sign)));
+        _mm256_store_ps(ody + i, _mm256_xor_ps(vy, _mm256_and_ps(outY, sign)));
+    }
+}
+
+// ---------------- Path selection ----------------
+struct SwarmPath {
+    const char* name;
+    SwarmKernel kernel;
+};
+
+inline SwarmPath swarmPath = { "scalar", swarmUpdateScalar };
+
+// Pick a kernel by name ("scalar", "sse", "avx"), or the best supported one
+// for nullptr / "auto". Returns false if the named path isn't available.
+inline bool swarmSelectPath(const char* name) {
+    bool hasAVX = __builtin_cpu_supports("avx");
+    if (!name || strcmp(name, "auto") == 0) name = hasAVX ? "avx" : "sse";
+    if (strcmp(name, "avx") == 0 && hasAVX) swarmPath = { "avx", swarmUpdateAVX };
+    else if (strcmp(name, "sse") == 0) swarmPath = { "sse", swarmUpdateSSE };
+    else if (strcmp(name, "scalar") == 0) swarmPath = { "scalar", swarmUpdateScalar };
+    else return false;
+    return true;
+}
+
+// Advance every agent one step in place with the selected kernel
+inline void swarmUpdate(MosquitoSwarm& s) {
+    swarmPath.kernel(s.x, s.y, s.dx, s.dy, s.x, s.y, s.dx, s.dy, 0, s.padded);
+}
+
+inline void swarmCopy(MosquitoSwarm& dst, const MosquitoSwarm& src) {
+    swarmFree(dst);
+    dst.count = src.count;
+    dst.padded = src.padded;
+    size_t bytes = src.padded * sizeof(float);
+    dst.x = swarmAlloc(src.padded); memcpy(dst.x, src.x, bytes);
+    dst.y = swarmAlloc(src.padded); memcpy(dst.y, src.y, bytes);
+    dst.dx = swarmAlloc(src.padded); memcpy(dst.dx, src.dx, bytes);
+    dst.dy = swarmAlloc(src.padded); memcpy(dst.dy, src.dy, bytes);
+    dst.size = swarmAlloc(src.padded); memcpy(dst.size, src.size, bytes);
+}
+
+// ---------------- Fixed-step scheduler ----------------
+// Agents per parallel chunk; big enough that a chunk outweighs the hand-off
+const int SWARM_CHUNK = 16384;
+
+struct SwarmScheduler {
+    MosquitoSwarm state[2];
+    int front = 0;                  // latest published state
+    long long published = 0;        // states published so far, under mutex
+    int reading = -1;               // state display() is drawing, or -1
+    std::mutex mutex;
+    std::condition_variable released;
+    ThreadPool* pool = nullptr;
+    double stepHz = 20.0;
+    void (*onStep)(MosquitoSwarm& next) = nullptr; // runs on each new state before it is published
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    bool paused = false;            // under mutex
+    std::condition_variable resumed;
+    // step statistics, written by the stepping thread
+    long long steps = 0;
+    double totalStepMs = 0, lastStepMs = 0;
+};
+
+// Take ownership of an initialised swarm and set up the double buffer
+inline void swarmSchedInit(SwarmScheduler& sched, MosquitoSwarm& initial, int threads, double stepHz) {
+    sched.state[0] = initial;
+    initial = MosquitoSwarm();
+    swarmCopy(sched.state[1], sched.state[0]);
+    sched.front = 0;
+    sched.pool = new ThreadPool(threads);
+    sched.stepHz = stepHz;
+}
+
+// Compute the next state into the back buffer, in parallel chunks, then publish it
+inline void swarmSchedStep(SwarmScheduler& sched) {
+    typedef std::chrono::steady_clock Clock;
+    int back;
+    {
+        // the renderer may still hold the old front: wait for it, never the reverse
+        std::unique_lock<std::mutex> lock(sched.mutex);
+        back = 1 - sched.front;
+        sched.released.wait(lock, [&] { return sched.reading != back; });
+    }
+    const MosquitoSwarm& in = sched.state[sched.front];
+    MosquitoSwarm& out = sched.state[back];
+    SwarmKernel kernel = swarmPath.kernel;
+
+    Clock::time_point t0 = Clock::now();
+    sched.pool->parallelFor(in.padded, SWARM_CHUNK, [&](int begin, int end) {
+        kernel(in.x, in.y, in.dx, in.dy, out.x, out.y, out.dx, out.dy, begin, end);
+    });
+    if (sched.onStep) sched.onStep(out);
+    sched.lastStepMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    sched.totalStepMs += sched.lastStepMs;
+    sched.steps++;
+
+    std::lock_guard<std::mutex> lock(sched.mutex);
+    sched.front = back;
+    sched.published++;
+}
+
+// Number of states published so far; changes whenever there is a newer one to draw
+inline long long swarmSchedPublished(SwarmScheduler& sched) {
+    std::lock_guard<std::mutex> lock(sched.mutex);
+    return sched.published;
+}
+
+// Latest complete state; hold it until swarmSchedRelease() (after the frame's
+// batch has been flushed, since instanced draws read the arrays then)
+inline const MosquitoSwarm& swarmSchedAcquire(SwarmScheduler& sched) {
+    std::lock_guard<std::mutex> lock(sched.mutex);
+    sched.reading = sched.front;
+    return sched.state[sched.reading];
+}
+
+inline void swarmSchedRelease(SwarmScheduler& sched) {
+    {
+        std::lock_guard<std::mutex> lock(sched.mutex);
+        sched.reading = -1;
+    }
+    sched.released.notify_one();
+}
+
+// Step at stepHz on a background thread until swarmSchedStop(). Late steps are
+// caught up, but never more than a few at once; a paused scheduler sleeps
+// until swarmSchedResume() and does not catch up on the pause.
+inline void swarmSchedStart(SwarmScheduler& sched) {
+    sched.running = true;
+    sched.thread = std::thread([&sched] {
+        typedef std::chrono::steady_clock Clock;
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / sched.stepHz));
+        Clock::time_point next = Clock::now() + period;
+        while (sched.running) {
+            {
+                std::unique_lock<std::mutex> lock(sched.mutex);
+                if (sched.paused) {
+                    sched.resumed.wait(lock, [&] { return !sched.paused || !sched.running; });
+                    next = Clock::now() + period;
+                }
+            }
+            std::this_thread::sleep_until(next);
+            for (int catchUp = 0; catchUp < 4 && Clock::now() >= next && sched.running; ++catchUp) {
+                swarmSchedStep(sched);
+                next += period;
+            }
+            if (Clock::now() >= next) next = Clock::now() + period; // too far behind: drop steps
+        }
+    });
+}
+
+// Stop stepping while nothing would move, and start again
+inline void swarmSchedPause(SwarmScheduler& sched) {
+    std::lock_guard<std::mutex> lock(sched.mutex);
+    sched.paused = true;
+}
+
+inline void swarmSchedResume(SwarmScheduler& sched) {
+    {
+        std::lock_guard<std::mutex> lock(sched.mutex);
+        sched.paused = false;
+    }
+    sched.resumed.notify_one();
+}
+
+inline void swarmSchedStop(SwarmScheduler& sched) {
+    if (!sched.running) return;
+    {
+        std::lock_guard<std::mutex> lock(sched.mutex);
+        sched.running = false;
+    }
+    sched.resumed.notify_one();
+    sched.thread.join();
+}
+
+inline void swarmSchedPrintStats(const SwarmScheduler& sched) {
+    if (sched.steps == 0) return;
+    printf("simulation: %lld steps, %.3f ms/step average (%d agents, %s, %d threads)\n",
+        sched.steps, sched.totalStepMs / sched.steps, sched.state[0].count, swarmPath.name, sched.pool->size());
+}
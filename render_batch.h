@@ -0,0 +1,529 @@
+// render_batch.h
+// Per-frame batch builder. Scene code keeps its immediate-mode shape
+// (batchBegin / batchColor / batchVertex / batchEnd), but vertices are collected
+// into contiguous position+color arrays grouped by primitive type (triangles,
+// lines, points) and drawn with a few vertex-array calls in batchFlush().
+//
+// Quads, polygons, fans and strips are split into triangles, line strips and
+// loops into line pairs. Grouping by type would reorder a 2D scene, so in
+// ordered mode (the default for the 2D programs) every primitive gets its own
+// depth layer and depth testing with GL_LEQUAL keeps the painter's order: the
+// depth buffer must be cleared every frame. 3D programs call batchInit3D() and
+// pass their own z.
+//
+// Repeated 2D shapes can be recorded once as a template mesh and drawn with
+// batchDrawInstances(): one glDrawArraysInstanced per primitive type when the
+// context has GL 3.3, otherwise expanded on the CPU into the frame batch.
+// The including program must define GL_GLEXT_PROTOTYPES before its first GL
+// header for the instancing entry points.
+//
+// Templates can also be placed by arbitrary per-instance 2D transforms
+// (BatchTransforms, a flat structure of arrays the caller fills):
+// batchDrawTransformed() applies them on the CPU with SSE, four instances at
+// a time, straight into the frame's lists, with no matrix stack involved.
+// The CPU path of batchDrawInstances() goes the same way.
+//
+// Large point sets that the caller fills itself (starfields) skip the
+// per-vertex calls: batchDrawPoints() draws a caller-owned vertex array as one
+// glDrawArrays of GL_POINTS at a given size.
+#pragma once
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <emmintrin.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+struct BatchVertex {
+    float x, y, z;
+    unsigned char r, g, b, a;
+};
+
+// 2D affine transform: x' = a*x + c*y + tx, y' = b*x + d*y + ty
+struct BatchTransform {
+    float a, b, c, d, tx, ty;
+};
+
+// Per-instance transforms as in BatchTransform, one array per coefficient.
+// Sized by batchTransformsResize(), with room for a last group of four read
+// from any first instance.
+struct BatchTransforms {
+    std::vector<float> a, b, c, d, tx, ty;
+    int count = 0;
+};
+
+// Template geometry in local coordinates, recorded with batchMeshBegin/End
+struct BatchMesh {
+    std::vector<BatchVertex> tris, lines;
+    GLuint vbo = 0;         // tris then lines, uploaded on first instanced draw
+};
+
+// One deferred instanced draw. The per-instance arrays are read at flush time.
+struct BatchInstanceDraw {
+    BatchMesh* mesh;
+    const float *x, *y, *scale, *dirX, *dirY;
+    int count;
+    float z, dirSign;
+    bool upright;
+};
+
+// One deferred point draw of caller-owned vertices, read at flush time
+struct BatchPointDraw {
+    const BatchVertex* vertices;
+    int count;
+    float size;                 // pixels
+};
+
+struct BatchStats {
+    int primitives = 0;     // batchBegin/batchEnd pairs this frame
+    long long vertices = 0; // vertices handed to GL this frame
+    int instances = 0;      // template instances drawn this frame
+    int flushes = 0;        // draw calls this frame
+    long long totalFlushes = 0;
+    long long frames = 0;
+};
+
+struct RenderBatch {
+    std::vector<BatchVertex> tris, lines, points;
+    std::vector<BatchVertex> prim;     // vertices of the primitive being built
+    std::vector<BatchInstanceDraw> instanceDraws;
+    std::vector<BatchPointDraw> pointDraws;
+    int instancing = -1;               // -1 not probed yet, 0 CPU expansion, 1 GL instancing
+    GLuint instanceProgram = 0;
+    bool savedOrdered = true;          // ordered flag while a mesh is being recorded
+    GLenum mode = GL_TRIANGLES;
+    unsigned char color[4] = { 255, 255, 255, 255 };
+    bool ordered = true;               // assign a depth layer per primitive
+    int layer = 0;
+    float layerZ = -1.0f;
+    std::vector<BatchTransform> xforms = { { 1, 0, 0, 1, 0, 0 } };
+    bool identity = true;
+    BatchStats stats;
+    void (*backend)() = nullptr;       // takes the lists instead of GL when set (soft_raster.h)
+};
+
+inline RenderBatch batch;
+
+// Layers step towards the viewer from the far plane of gluOrtho2D(-1, 1, -1, 1):
+// eye z = -1 is depth 1.0 and each layer is 8 steps of a 24-bit depth buffer
+const float BATCH_LAYER_STEP = 1.0f / (1 << 20);
+const int BATCH_MAX_LAYERS = 2 * (1 << 20) - 1;
+
+// 2D programs: depth-ordered layers (call once after the projection is set)
+inline void batchInit2D() {
+    batch.ordered = true;
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+}
+
+// 3D programs: vertices keep the z they are given
+inline void batchInit3D() {
+    batch.ordered = false;
+}
+
+// Eye-space z of a fresh layer. Things drawn outside the batch (bitmap text)
+// use it as their raster z so they stay in order with batched geometry.
+inline float batchNextLayerZ() {
+    if (batch.layer < BATCH_MAX_LAYERS) batch.layer++;
+    batch.layerZ = -1.0f + batch.layer * BATCH_LAYER_STEP;
+    return batch.layerZ;
+}
+
+inline unsigned char batchColorByte(float c) {
+    return (unsigned char)(c <= 0.0f ? 0 : c >= 1.0f ? 255 : c * 255.0f + 0.5f);
+}
+
+inline void batchColor4f(float r, float g, float b, float a) {
+    batch.color[0] = batchColorByte(r);
+    batch.color[1] = batchColorByte(g);
+    batch.color[2] = batchColorByte(b);
+    batch.color[3] = batchColorByte(a);
+}
+
+inline void batchColor3f(float r, float g, float b) {
+    batchColor4f(r, g, b, 1.0f);
+}
+
+inline void batchBegin(GLenum mode) {
+    batch.mode = mode;
+    batch.prim.clear();
+    if (batch.ordered) batchNextLayerZ();
+}
+
+inline void batchVertex3f(float x, float y, float z) {
+    if (!batch.identity) {
+        const BatchTransform& m = batch.xforms.back();
+        float tx = m.a * x + m.c * y + m.tx;
+        y = m.b * x + m.d * y + m.ty;
+        x = tx;
+    }
+    BatchVertex v = { x, y, z, batch.color[0], batch.color[1], batch.color[2], batch.color[3] };
+    batch.prim.push_back(v);
+}
+
+inline void batchVertex2f(float x, float y) {
+    batchVertex3f(x, y, batch.ordered ? batch.layerZ : 0.0f);
+}
+
+// One untransformed 3D line in the current color, appended straight to the
+// line list (for programs emitting many thousands of edges)
+inline void batchLine3f(float x0, float y0, float z0, float x1, float y1, float z1) {
+    BatchVertex a = { x0, y0, z0, batch.color[0], batch.color[1], batch.color[2], batch.color[3] };
+    BatchVertex b = { x1, y1, z1, batch.color[0], batch.color[1], batch.color[2], batch.color[3] };
+    batch.lines.push_back(a);
+    batch.lines.push_back(b);
+    batch.stats.primitives++;
+}
+
+// Split the finished primitive into the triangle / line / point lists
+inline void batchEnd() {
+    const std::vector<BatchVertex>& p = batch.prim;
+    int n = (int)p.size();
+    std::vector<BatchVertex>& tris = batch.tris;
+    std::vector<BatchVertex>& lines = batch.lines;
+    switch (batch.mode) {
+    case GL_POINTS:
+        batch.points.insert(batch.points.end(), p.begin(), p.end());
+        break;
+    case GL_LINES:
+        lines.insert(lines.end(), p.begin(), p.begin() + (n & ~1));
+        break;
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+        for (int i = 0; i + 1 < n; ++i) { lines.push_back(p[i]); lines.push_back(p[i + 1]); }
+        if (batch.mode == GL_LINE_LOOP && n > 2) { lines.push_back(p[n - 1]); lines.push_back(p[0]); }
+        break;
+    case GL_TRIANGLES:
+        tris.insert(tris.end(), p.begin(), p.begin() + n / 3 * 3);
+        break;
+    case GL_QUADS:
+        for (int i = 0; i + 3 < n; i += 4) {
+            tris.push_back(p[i]); tris.push_back(p[i + 1]); tris.push_back(p[i + 2]);
+            tris.push_back(p[i]); tris.push_back(p[i + 2]); tris.push_back(p[i + 3]);
+        }
+        break;
+    case GL_TRIANGLE_FAN:
+    case GL_POLYGON:
+        for (int i = 1; i + 1 < n; ++i) { tris.push_back(p[0]); tris.push_back(p[i]); tris.push_back(p[i + 1]); }
+        break;
+    case GL_TRIANGLE_STRIP:
+        for (int i = 0; i + 2 < n; ++i) {
+            if (i & 1) { tris.push_back(p[i + 1]); tris.push_back(p[i]); tris.push_back(p[i + 2]); }
+            else { tris.push_back(p[i]); tris.push_back(p[i + 1]); tris.push_back(p[i + 2]); }
+        }
+        break;
+    case GL_QUAD_STRIP:
+        for (int i = 0; i + 3 < n; i += 2) {
+            tris.push_back(p[i]); tris.push_back(p[i + 1]); tris.push_back(p[i + 3]);
+            tris.push_back(p[i]); tris.push_back(p[i + 3]); tris.push_back(p[i + 2]);
+        }
+        break;
+    default:
+        break;
+    }
+    batch.stats.primitives++;
+}
+
+// ---- CPU-side matrix stack for batched 2D geometry ----
+inline void batchPushMatrix() {
+    batch.xforms.push_back(batch.xforms.back());
+}
+
+inline void batchPopMatrix() {
+    if (batch.xforms.size() > 1) batch.xforms.pop_back();
+    const BatchTransform& m = batch.xforms.back();
+    batch.identity = m.a == 1 && m.b == 0 && m.c == 0 && m.d == 1 && m.tx == 0 && m.ty == 0;
+}
+
+inline void batchTranslatef(float x, float y) {
+    BatchTransform& m = batch.xforms.back();
+    m.tx += m.a * x + m.c * y;
+    m.ty += m.b * x + m.d * y;
+    batch.identity = false;
+}
+
+// Rotation about z, in degrees like glRotatef(deg, 0, 0, 1)
+inline void batchRotatef(float deg) {
+    BatchTransform& m = batch.xforms.back();
+    float rad = deg * 3.14159265f / 180.0f;
+    float cs = cosf(rad), sn = sinf(rad);
+    BatchTransform r = m;
+    m.a = r.a * cs + r.c * sn;  m.b = r.b * cs + r.d * sn;
+    m.c = -r.a * sn + r.c * cs; m.d = -r.b * sn + r.d * cs;
+    batch.identity = false;
+}
+
+// ---- Instanced template meshes ----
+
+// Route the following batchBegin..batchEnd calls into mesh (local coordinates,
+// z = 0) instead of the frame
+inline void batchMeshBegin(BatchMesh& mesh) {
+    mesh.tris.swap(batch.tris);
+    mesh.lines.swap(batch.lines);
+    batch.savedOrdered = batch.ordered;
+    batch.ordered = false;
+}
+
+inline void batchMeshEnd(BatchMesh& mesh) {
+    mesh.tris.swap(batch.tris);
+    mesh.lines.swap(batch.lines);
+    batch.ordered = batch.savedOrdered;
+}
+
+// Instance placement shared by the GL and CPU paths: the mesh's +x axis points
+// along dirSign * (dirX, dirY) and +y is perpendicular to it; "upright" meshes
+// are mirrored rather than turned upside down when heading left.
+const char* const BATCH_INSTANCE_VS =
+    "#version 120\n"
+    "attribute vec3 pos;\n"
+    "attribute vec4 color;\n"
+    "attribute float ix, iy, iscale, idx, idy;\n"
+    "uniform float layerZ, dirSign, upright;\n"
+    "varying vec4 vColor;\n"
+    "void main() {\n"
+    "    vec2 f = dirSign * vec2(idx, idy);\n"
+    "    float len = length(f);\n"
+    "    f = len > 1e-12 ? f / len : vec2(1.0, 0.0);\n"
+    "    vec2 u = vec2(-f.y, f.x);\n"
+    "    if (upright > 0.5 && u.y < 0.0) u = -u;\n"
+    "    vec2 p = vec2(ix, iy) + iscale * (pos.x * f + pos.y * u);\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(p, layerZ, 1.0);\n"
+    "    vColor = color;\n"
+    "}\n";
+const char* const BATCH_INSTANCE_FS =
+    "#version 120\n"
+    "varying vec4 vColor;\n"
+    "void main() { gl_FragColor = vColor; }\n";
+
+// Instancing needs GL 3.3 (attribute divisors) and a compiled program; probed
+// once, the answer sticks. Setting batch.instancing = 0 beforehand forces the
+// CPU path.
+inline bool batchInstancingAvailable() {
+    if (batch.backend) return false; // a software backend only takes the lists
+    if (batch.instancing >= 0) return batch.instancing == 1;
+    batch.instancing = 0;
+    int major = 0, minor = 0;
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (!version || sscanf(version, "%d.%d", &major, &minor) != 2 || major * 10 + minor < 33) return false;
+
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER), fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(vs, 1, &BATCH_INSTANCE_VS, nullptr);
+    glShaderSource(fs, 1, &BATCH_INSTANCE_FS, nullptr);
+    glCompileShader(vs);
+    glCompileShader(fs);
+    GLuint prog = glCreateProgram();
+    glAttachShader(prog, vs);
+    glAttachShader(prog, fs);
+    const char* attribs[] = { "pos", "color", "ix", "iy", "iscale", "idx", "idy" };
+    for (int i = 0; i < 7; ++i) glBindAttribLocation(prog, i, attribs[i]);
+    glLinkProgram(prog);
+    GLint linked = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    if (!linked) { glDeleteProgram(prog); return false; }
+    batch.instanceProgram = prog;
+    batch.instancing = 1;
+    return true;
+}
+
+// ---- Transform batching ----
+inline void batchTransformsResize(BatchTransforms& t, int count) {
+    t.count = count;
+    for (std::vector<float>* v : { &t.a, &t.b, &t.c, &t.d, &t.tx, &t.ty }) v->resize(count + 3, 0.0f);
+}
+
+// Append the template placed by transforms [first, first + count) to the
+// frame's triangle and line lists at depth z. Each template vertex is placed
+// for four instances at once and the four results transposed into vertices.
+inline void batchApplyTransforms(const BatchMesh& mesh, const BatchTransforms& t, int first, int count, float z) {
+    const __m128 zs = _mm_set1_ps(z);
+    for (int pass = 0; pass < 2; ++pass) {
+        const std::vector<BatchVertex>& src = pass == 0 ? mesh.tris : mesh.lines;
+        std::vector<BatchVertex>& dst = pass == 0 ? batch.tris : batch.lines;
+        int nv = (int)src.size();
+        if (nv == 0) continue;
+        size_t base = dst.size();
+        dst.resize(base + (size_t)nv * count);
+        BatchVertex* out = &dst[base];
+        for (int i = 0; i < count; i += 4) {
+            int at = first + i, lanes = count - i < 4 ? count - i : 4;
+            __m128 a = _mm_loadu_ps(&t.a[at]), b = _mm_loadu_ps(&t.b[at]), c = _mm_loadu_ps(&t.c[at]);
+            __m128 d = _mm_loadu_ps(&t.d[at]), tx = _mm_loadu_ps(&t.tx[at]), ty = _mm_loadu_ps(&t.ty[at]);
+            BatchVertex* o = out + (size_t)i * nv;
+            for (int v = 0; v < nv; ++v, ++o) {
+                const BatchVertex& p = src[v];
+                __m128 vx = _mm_set1_ps(p.x), vy = _mm_set1_ps(p.y);
+                float rgba;
+                memcpy(&rgba, &p.r, 4);
+                __m128 r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, vx), _mm_mul_ps(c, vy)), tx);
+                __m128 r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b, vx), _mm_mul_ps(d, vy)), ty);
+                __m128 r2 = zs, r3 = _mm_set1_ps(rgba);
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(&o[0].x, r0);
+                if (lanes > 1) _mm_storeu_ps(&o[nv].x, r1);
+                if (lanes > 2) _mm_storeu_ps(&o[2 * nv].x, r2);
+                if (lanes > 3) _mm_storeu_ps(&o[3 * nv].x, r3);
+            }
+        }
+    }
+}
+
+// Draw the template once per transform [first, first + count) as one layer of the frame
+inline void batchDrawTransformed(const BatchMesh& mesh, const BatchTransforms& t, int first, int count) {
+    if (count <= 0) return;
+    float z = batch.ordered ? batchNextLayerZ() : 0.0f;
+    batchApplyTransforms(mesh, t, first, count, z);
+    batch.stats.instances += count;
+}
+
+// CPU path of the instanced draws: each instance's placement as a transform
+inline void batchExpandInstances(const BatchInstanceDraw& d) {
+    static BatchTransforms t; // reused from draw to draw
+    batchTransformsResize(t, d.count);
+    for (int i = 0; i < d.count; ++i) {
+        float fx = d.dirSign * d.dirX[i], fy = d.dirSign * d.dirY[i];
+        float len2 = fx * fx + fy * fy;
+        if (len2 > 1e-24f) { float inv = 1.0f / sqrtf(len2); fx *= inv; fy *= inv; }
+        else { fx = 1.0f; fy = 0.0f; }
+        float ux = -fy, uy = fx;
+        if (d.upright && uy < 0.0f) { ux = -ux; uy = -uy; }
+        float s = d.scale[i];
+        t.a[i] = s * fx; t.b[i] = s * fy;
+        t.c[i] = s * ux; t.d[i] = s * uy;
+        t.tx[i] = d.x[i]; t.ty[i] = d.y[i];
+    }
+    batchApplyTransforms(*d.mesh, t, 0, d.count, d.z);
+}
+
+// Draw `count` copies of mesh, one per (x, y, scale, dir) entry of the
+// structure-of-arrays inputs, as one layer of the frame
+inline void batchDrawInstances(BatchMesh& mesh, const float* x, const float* y, const float* scale,
+    const float* dirX, const float* dirY, int count, float dirSign, bool upright) {
+    if (count <= 0) return;
+    float z = batch.ordered ? batchNextLayerZ() : 0.0f;
+    BatchInstanceDraw d = { &mesh, x, y, scale, dirX, dirY, count, z, dirSign, upright };
+    if (batchInstancingAvailable()) batch.instanceDraws.push_back(d);
+    else batchExpandInstances(d);
+    batch.stats.instances += count;
+}
+
+inline void batchFlushInstances() {
+    if (batch.instanceDraws.empty()) return;
+    GLuint prog = batch.instanceProgram;
+    glUseProgram(prog);
+    for (int a = 0; a < 7; ++a) glEnableVertexAttribArray(a);
+    for (int a = 2; a < 7; ++a) glVertexAttribDivisor(a, 1);
+
+    for (const BatchInstanceDraw& d : batch.instanceDraws) {
+        BatchMesh& m = *d.mesh;
+        if (!m.vbo) {
+            std::vector<BatchVertex> all(m.tris);
+            all.insert(all.end(), m.lines.begin(), m.lines.end());
+            glGenBuffers(1, &m.vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+            glBufferData(GL_ARRAY_BUFFER, all.size() * sizeof(BatchVertex), all.data(), GL_STATIC_DRAW);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (const void*)0);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(BatchVertex), (const void*)(3 * sizeof(float)));
+        glBindBuffer(GL_ARRAY_BUFFER, 0); // per-instance data comes straight from client memory
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 0, d.x);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 0, d.y);
+        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, 0, d.scale);
+        glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, 0, d.dirX);
+        glVertexAttribPointer(6, 1, GL_FLOAT, GL_FALSE, 0, d.dirY);
+        glUniform1f(glGetUniformLocation(prog, "layerZ"), d.z);
+        glUniform1f(glGetUniformLocation(prog, "dirSign"), d.dirSign);
+        glUniform1f(glGetUniformLocation(prog, "upright"), d.upright ? 1.0f : 0.0f);
+        if (!m.tris.empty()) {
+            glDrawArraysInstanced(GL_TRIANGLES, 0, (GLsizei)m.tris.size(), d.count);
+            batch.stats.vertices += (long long)m.tris.size() * d.count;
+            batch.stats.flushes++;
+        }
+        if (!m.lines.empty()) {
+            glDrawArraysInstanced(GL_LINES, (GLint)m.tris.size(), (GLsizei)m.lines.size(), d.count);
+            batch.stats.vertices += (long long)m.lines.size() * d.count;
+            batch.stats.flushes++;
+        }
+    }
+
+    for (int a = 2; a < 7; ++a) glVertexAttribDivisor(a, 0);
+    for (int a = 0; a < 7; ++a) glDisableVertexAttribArray(a);
+    glUseProgram(0);
+    batch.instanceDraws.clear();
+}
+
+// Draw one list with a single glDrawArrays call
+inline void batchDrawList(std::vector<BatchVertex>& list, GLenum mode) {
+    if (list.empty()) return;
+    glVertexPointer(3, GL_FLOAT, sizeof(BatchVertex), &list[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(BatchVertex), &list[0].r);
+    glDrawArrays(mode, 0, (GLsizei)list.size());
+    batch.stats.vertices += (int)list.size();
+    batch.stats.flushes++;
+    list.clear();
+}
+
+// Draw `count` points of `size` pixels from vertices the caller filled (with
+// a layer z from batchNextLayerZ() in ordered mode) and keeps until the flush
+inline void batchDrawPoints(const BatchVertex* vertices, int count, float size) {
+    if (count <= 0) return;
+    batch.pointDraws.push_back({ vertices, count, size });
+    batch.stats.primitives++;
+}
+
+inline void batchFlushPoints() {
+    for (const BatchPointDraw& d : batch.pointDraws) {
+        glPointSize(d.size);
+        glVertexPointer(3, GL_FLOAT, sizeof(BatchVertex), &d.vertices[0].x);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(BatchVertex), &d.vertices[0].r);
+        glDrawArrays(GL_POINTS, 0, (GLsizei)d.count);
+        batch.stats.vertices += d.count;
+        batch.stats.flushes++;
+    }
+    if (!batch.pointDraws.empty()) glPointSize(1.0f);
+    batch.pointDraws.clear();
+}
+
+// Draw everything collected so far; the frame carries on with the next layer
+inline void batchSubmit() {
+    if (batch.backend) {
+        batch.backend();
+        return;
+    }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    batchDrawList(batch.tris, GL_TRIANGLES);
+    batchDrawList(batch.lines, GL_LINES);
+    batchDrawList(batch.points, GL_POINTS);
+    batchFlushPoints();
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    batchFlushInstances();
+}
+
+// Submit everything collected this frame; call once at the end of display()
+inline void batchFlush() {
+    batchSubmit();
+
+    batch.stats.totalFlushes += batch.stats.flushes;
+    batch.stats.frames++;
+}
+
+// Start a new frame: reset layers and per-frame counters
+inline void batchBeginFrame() {
+    batch.layer = 0;
+    batch.layerZ = -1.0f;
+    batch.stats.primitives = batch.stats.vertices = batch.stats.instances = batch.stats.flushes = 0;
+}
+
+// Average glDrawArrays calls per frame so far
+inline void batchPrintStats() {
+    if (batch.stats.frames == 0) return;
+    printf("batches: %.2f flushed per frame (last frame: %d primitives + %d instances -> %d draws, %lld vertices)\n",
+        (double)batch.stats.totalFlushes / batch.stats.frames,
+        batch.stats.primitives, batch.stats.instances, batch.stats.flushes, batch.stats.vertices);
+}
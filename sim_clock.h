@@ -0,0 +1,72 @@
+// sim_clock.h
+// Fixed-timestep clock for the windowed programs. The simulation advances in
+// steps of a fixed length of wall-clock time however often frames are drawn:
+// each frame adds the time since the previous one to an accumulator and runs
+// as many whole steps as it holds. The remainder, as a fraction of a step, is
+// the factor to interpolate between the last two simulation states when
+// drawing. Slow frames run several steps, so the story keeps its wall-clock
+// timing under load; fast ones draw in-between states, so a faster machine
+// gets more frames, not a faster story.
+//
+// The programs drive it from glutIdleFunc instead of a re-armed glutTimerFunc,
+// so frames are not capped (the swap paces them when the driver syncs to
+// vblank). Headless runs don't use it: they step once per frame and draw the
+// newest state, which keeps them deterministic.
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+struct SimClock {
+    typedef std::chrono::steady_clock Clock;
+    double step = 1.0 / 30;     // seconds per simulation step
+    double accumulator = 0;     // seconds not yet simulated
+    Clock::time_point last;
+    bool started = false;
+    int maxSteps = 10;          // per frame; beyond it the clock slips (a stalled window, a debugger)
+};
+
+inline void simClockInit(SimClock& c, double stepsPerSec) {
+    c.step = 1.0 / stepsPerSec;
+    c.started = false;
+}
+
+// Forget the time gone by: the next frame starts from now with no steps due
+// (after a pause, or when the program idled with nothing to animate)
+inline void simClockReset(SimClock& c) {
+    c.started = false;
+}
+
+// Take the wall-clock time since the last call; returns the number of steps
+// to run this frame
+inline int simClockAdvance(SimClock& c) {
+    SimClock::Clock::time_point now = SimClock::Clock::now();
+    if (!c.started) {
+        c.started = true;
+        c.last = now;
+        c.accumulator = 0;
+    }
+    c.accumulator += std::chrono::duration<double>(now - c.last).count();
+    c.last = now;
+    int n = (int)(c.accumulator / c.step);
+    if (n > c.maxSteps) {
+        c.accumulator -= (n - c.maxSteps) * c.step;
+        n = c.maxSteps;
+    }
+    c.accumulator -= n * c.step;
+    return n;
+}
+
+// How far the clock is between the last step and the next one, 0..1: the
+// weight of the newest state when interpolating
+inline float simClockAlpha(const SimClock& c) {
+    float a = (float)(c.accumulator / c.step);
+    return a < 0 ? 0 : a > 1 ? 1 : a;
+}
+
+// Sleep until the next step is due; for frames that had nothing new to draw,
+// so an idle loop doesn't spin
+inline void simClockWait(const SimClock& c) {
+    double left = c.step - c.accumulator;
+    if (left > 0) std::this_thread::sleep_for(std::chrono::duration<double>(left));
+}
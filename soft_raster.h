@@ -0,0 +1,455 @@
+// soft_raster.h
+// Tile-based software rasterizer for the headless mode of the 2D programs, for
+// render nodes without a GPU. It takes the frame's batched triangles, lines and
+// points (render_batch.h) and the glyph quads of text_atlas.h instead of GL,
+// sorts them into 64x64 screen tiles as they arrive, and in presentFrame()
+// rasterizes all tiles in parallel on a thread pool into an RGBA framebuffer,
+// which headless.h reads back for --out and --video.
+//
+// Triangles are scan-converted with integer edge functions in 1/16 pixel fixed
+// point, four pixels at a time with SSE2; a pixel is covered when its centre is
+// inside (top-left rule on the edges). Edges that clear a whole tile are
+// dropped for that tile, and the ones crossing it stay small enough for 32-bit
+// lanes. Lines cover one pixel per column (or row) of their major axis, points
+// the pixel they fall in, or a square of pixels around it for bigger points.
+// Depth follows the batch's GL_LEQUAL layers: a fragment is kept unless
+// something nearer was drawn, ties go to the later one. There is no blending,
+// as in the GL path. Layer caches are bypassed; everything is rasterized
+// every frame.
+//
+// Options: --soft-raster [--raster-threads N] (default: one per hardware thread)
+#pragma once
+
+#include "headless.h"
+#include "render_batch.h"
+#include "text_atlas.h"
+#include "thread_pool.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+const int SOFT_TILE = 64;                   // tile side in pixels
+const int SOFT_TILE_STRIDE = SOFT_TILE + 4; // room for the last 4-pixel step of a row
+const int SOFT_SUBPIXEL = 16;               // fixed-point steps per pixel
+const float SOFT_MAX_COORD = 16384.0f;      // primitives reaching further off-screen (pixels) are dropped
+
+enum SoftKind : uint32_t { SOFT_TRI, SOFT_LINE, SOFT_POINT, SOFT_GLYPH };
+
+struct SoftTri {
+    int x[3], y[3];             // window position in fixed point, counter-clockwise
+    float z;                    // nearer is larger
+    uint32_t color[3];
+    bool smooth;                // vertex colors differ
+};
+
+struct SoftLine { float x0, y0, x1, y1, z; uint32_t color; };
+struct SoftPoint { int x, y, size; float z; uint32_t color; }; // (x, y): lower left pixel
+struct SoftGlyph { int x, y, w, h, u; float z; uint32_t color; }; // u: atlas column
+
+struct SoftRaster {
+    bool enabled = false;       // --soft-raster
+    int threads = 0;            // --raster-threads, 0: one per hardware thread
+    int width = 0, height = 0, tilesX = 0, tilesY = 0;
+    std::vector<uint32_t> frame; // RGBA8, R in the low byte, bottom-up rows like GL
+    std::vector<SoftTri> tris;
+    std::vector<SoftLine> lines;
+    std::vector<SoftPoint> points;
+    std::vector<SoftGlyph> glyphs;
+    std::vector<std::vector<uint32_t>> bins; // per tile: kind << 28 | index, in drawing order
+    ThreadPool* pool = nullptr;
+    // statistics
+    long long frames = 0, binEntries = 0;
+    double binMs = 0, rasterMs = 0;
+};
+
+inline SoftRaster softRaster;
+
+inline bool softRasterParseArg(int argc, char** argv, int& i) {
+    if (strcmp(argv[i], "--soft-raster") == 0) { softRaster.enabled = true; return true; }
+    if (strcmp(argv[i], "--raster-threads") == 0 && i + 1 < argc) { softRaster.threads = atoi(argv[++i]); return true; }
+    return false;
+}
+
+inline uint32_t softPack(unsigned char r, unsigned char g, unsigned char b) {
+    return r | (uint32_t)g << 8 | (uint32_t)b << 16 | 0xFF000000u; // the GL surface has no alpha either
+}
+
+// Queue primitive `index` of `kind` in every tile its pixel box [x0, x1] x [y0, y1] touches
+inline void softBin(SoftKind kind, size_t index, int x0, int y0, int x1, int y1) {
+    SoftRaster& s = softRaster;
+    x0 = std::max(x0, 0); y0 = std::max(y0, 0);
+    x1 = std::min(x1, s.width - 1); y1 = std::min(y1, s.height - 1);
+    if (x0 > x1 || y0 > y1) return;
+    uint32_t entry = (uint32_t)kind << 28 | (uint32_t)index;
+    for (int ty = y0 / SOFT_TILE; ty <= y1 / SOFT_TILE; ++ty)
+        for (int tx = x0 / SOFT_TILE; tx <= x1 / SOFT_TILE; ++tx) {
+            s.bins[(size_t)ty * s.tilesX + tx].push_back(entry);
+            s.binEntries++;
+        }
+}
+
+// ---------------- Taking the frame ----------------
+struct SoftView {
+    float m[16];                // projection * modelview
+    int viewport[4];
+};
+
+inline void softCaptureView(SoftView& v) {
+    float mv[16], proj[16];
+    glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+    glGetFloatv(GL_PROJECTION_MATRIX, proj);
+    glGetIntegerv(GL_VIEWPORT, v.viewport);
+    for (int col = 0; col < 4; ++col)
+        for (int row = 0; row < 4; ++row) {
+            float sum = 0;
+            for (int k = 0; k < 4; ++k) sum += proj[k * 4 + row] * mv[col * 4 + k];
+            v.m[col * 4 + row] = sum;
+        }
+}
+
+// Window position and depth key of a batch vertex; false when it can't be drawn
+inline bool softWindow(const SoftView& v, const BatchVertex& p, float& x, float& y, float& z) {
+    const float* m = v.m;
+    float cw = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+    if (cw <= 0) return false;
+    float cx = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+    float cy = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+    float cz = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14];
+    x = v.viewport[0] + (cx / cw + 1.0f) * 0.5f * v.viewport[2];
+    y = v.viewport[1] + (cy / cw + 1.0f) * 0.5f * v.viewport[3];
+    z = -cz / cw;
+    return fabsf(x) < SOFT_MAX_COORD && fabsf(y) < SOFT_MAX_COORD;
+}
+
+// Points of `size` pixels cover the size x size pixels centred on them, as GL's
+// aliased points
+inline void softTakePoints(const SoftView& view, const BatchVertex* v, int count, int size) {
+    SoftRaster& s = softRaster;
+    float back = (size - 1) * 0.5f;
+    for (int i = 0; i < count; ++i) {
+        float x, y, z;
+        if (!softWindow(view, v[i], x, y, z)) continue;
+        SoftPoint p = { (int)floorf(x - back), (int)floorf(y - back), size, z, softPack(v[i].r, v[i].g, v[i].b) };
+        softBin(SOFT_POINT, s.points.size(), p.x, p.y, p.x + size - 1, p.y + size - 1);
+        s.points.push_back(p);
+    }
+}
+
+// batch.backend: set up and bin the batch's lists, then empty them
+inline void softRasterTakeBatch() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    SoftRaster& s = softRaster;
+    SoftView view;
+    softCaptureView(view);
+
+    const std::vector<BatchVertex>& tris = batch.tris;
+    for (size_t i = 0; i + 2 < tris.size(); i += 3) {
+        SoftTri t;
+        float x = 0, y = 0, z[3];
+        bool ok = true;
+        for (int k = 0; k < 3 && ok; ++k) {
+            ok = softWindow(view, tris[i + k], x, y, z[k]);
+            t.x[k] = (int)lrintf(x * SOFT_SUBPIXEL);
+            t.y[k] = (int)lrintf(y * SOFT_SUBPIXEL);
+            t.color[k] = softPack(tris[i + k].r, tris[i + k].g, tris[i + k].b);
+        }
+        if (!ok) continue;
+        long long area = (long long)(t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (long long)(t.x[2] - t.x[0]) * (t.y[1] - t.y[0]);
+        if (area == 0) continue;
+        if (area < 0) {
+            std::swap(t.x[1], t.x[2]);
+            std::swap(t.y[1], t.y[2]);
+            std::swap(t.color[1], t.color[2]);
+        }
+        t.z = z[0]; // 2D layers: one depth per primitive
+        t.smooth = t.color[0] != t.color[1] || t.color[0] != t.color[2];
+        int minX = std::min({ t.x[0], t.x[1], t.x[2] }), maxX = std::max({ t.x[0], t.x[1], t.x[2] });
+        int minY = std::min({ t.y[0], t.y[1], t.y[2] }), maxY = std::max({ t.y[0], t.y[1], t.y[2] });
+        // pixels whose centre (16 p + 8) can be inside
+        const int half = SOFT_SUBPIXEL / 2;
+        softBin(SOFT_TRI, s.tris.size(), (minX - half + SOFT_SUBPIXEL - 1) >> 4, (minY - half + SOFT_SUBPIXEL - 1) >> 4,
+            (maxX - half) >> 4, (maxY - half) >> 4);
+        s.tris.push_back(t);
+    }
+
+    const std::vector<BatchVertex>& lines = batch.lines;
+    for (size_t i = 0; i + 1 < lines.size(); i += 2) {
+        SoftLine l;
+        float z1;
+        if (!softWindow(view, lines[i], l.x0, l.y0, l.z) || !softWindow(view, lines[i + 1], l.x1, l.y1, z1)) continue;
+        // snapped like the GL rasterizer's subpixel grid, so endpoints on pixel edges stay on them
+        for (float* c : { &l.x0, &l.y0, &l.x1, &l.y1 }) *c = roundf(*c * 256.0f) / 256.0f;
+        l.color = softPack(lines[i + 1].r, lines[i + 1].g, lines[i + 1].b); // flat shading uses the last vertex
+        softBin(SOFT_LINE, s.lines.size(), (int)floorf(std::min(l.x0, l.x1)), (int)floorf(std::min(l.y0, l.y1)),
+            (int)floorf(std::max(l.x0, l.x1)), (int)floorf(std::max(l.y0, l.y1)));
+        s.lines.push_back(l);
+    }
+
+    softTakePoints(view, batch.points.data(), (int)batch.points.size(), 1);
+    int pointDrawn = 0;
+    for (const BatchPointDraw& d : batch.pointDraws) {
+        softTakePoints(view, d.vertices, d.count, std::max(1, (int)lrintf(d.size)));
+        pointDrawn += d.count;
+    }
+    batch.pointDraws.clear();
+
+    batch.stats.vertices += (int)(tris.size() + lines.size() + batch.points.size()) + pointDrawn;
+    batch.stats.flushes++;
+    batch.tris.clear();
+    batch.lines.clear();
+    batch.points.clear();
+    s.binMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// textAtlas.backend: bin the queued glyph quads (whole pixels, see text_atlas.h)
+inline void softRasterTakeText() {
+    SoftRaster& s = softRaster;
+    const TextAtlas& t = textAtlas;
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    for (size_t i = 0; i + 3 < t.vertices.size(); i += 4) {
+        const TextVertex& a = t.vertices[i];
+        const TextVertex& b = t.vertices[i + 2];
+        SoftGlyph g;
+        g.x = viewport[0] + (int)a.x;
+        g.y = viewport[1] + (int)a.y;
+        g.w = (int)(b.x - a.x);
+        g.h = (int)(b.y - a.y);
+        g.u = (int)lrintf(a.u * t.texW);
+        g.z = a.z;
+        g.color = softPack(a.r, a.g, a.b);
+        softBin(SOFT_GLYPH, s.glyphs.size(), g.x, g.y, g.x + g.w - 1, g.y + g.h - 1);
+        s.glyphs.push_back(g);
+    }
+}
+
+// ---------------- Rasterizing a tile ----------------
+// The tile's own color and depth, SOFT_TILE_STRIDE pixels per row; (ox, oy) is
+// its lower-left pixel
+struct SoftTile {
+    uint32_t* color;
+    float* depth;
+    int ox, oy, w, h;
+};
+
+inline void softPlot(const SoftTile& t, int x, int y, float z, uint32_t color) {
+    size_t i = (size_t)(y - t.oy) * SOFT_TILE_STRIDE + (x - t.ox);
+    if (z >= t.depth[i]) {
+        t.depth[i] = z;
+        t.color[i] = color;
+    }
+}
+
+inline uint32_t softLerpColor(const uint32_t* c, float w0, float w1, float w2) {
+    uint32_t out = 0xFF000000u;
+    for (int ch = 0; ch < 24; ch += 8) {
+        float v = w0 * ((c[0] >> ch) & 255) + w1 * ((c[1] >> ch) & 255) + w2 * ((c[2] >> ch) & 255);
+        out |= (uint32_t)std::min(255.0f, std::max(0.0f, v + 0.5f)) << ch;
+    }
+    return out;
+}
+
+inline void softTriangle(const SoftTile& tile, const SoftTri& t) {
+    const int half = SOFT_SUBPIXEL / 2;
+    int bx0 = std::max(tile.ox, (std::min({ t.x[0], t.x[1], t.x[2] }) - half + SOFT_SUBPIXEL - 1) >> 4);
+    int by0 = std::max(tile.oy, (std::min({ t.y[0], t.y[1], t.y[2] }) - half + SOFT_SUBPIXEL - 1) >> 4);
+    int bx1 = std::min(tile.ox + tile.w - 1, (std::max({ t.x[0], t.x[1], t.x[2] }) - half) >> 4);
+    int by1 = std::min(tile.oy + tile.h - 1, (std::max({ t.y[0], t.y[1], t.y[2] }) - half) >> 4);
+    if (bx0 > bx1 || by0 > by1) return;
+
+    // edge i runs from vertex i to i + 1; inside is E >= 0 after the fill-rule bias
+    long long e[3];
+    int stepX[3], stepY[3], crossing[3], n = 0;
+    for (int i = 0; i < 3; ++i) {
+        int j = (i + 1) % 3;
+        long long A = t.y[i] - t.y[j], B = t.x[j] - t.x[i];
+        long long C = -A * t.x[i] - B * t.y[i];
+        int bias = (A > 0 || (A == 0 && B < 0)) ? 0 : -1;
+        e[i] = A * (SOFT_SUBPIXEL * bx0 + half) + B * (SOFT_SUBPIXEL * by0 + half) + C + bias;
+        stepX[i] = (int)(A * SOFT_SUBPIXEL);
+        stepY[i] = (int)(B * SOFT_SUBPIXEL);
+        long long dx = (long long)stepX[i] * (bx1 - bx0 + 3), dy = (long long)stepY[i] * (by1 - by0);
+        long long lo = e[i] + std::min(0LL, dx) + std::min(0LL, dy), hi = e[i] + std::max(0LL, dx) + std::max(0LL, dy);
+        if (hi < 0) return;                         // the box is outside this edge
+        if (lo < 0 || t.smooth) crossing[n++] = i;  // otherwise it is inside everywhere
+    }
+
+    if (t.smooth) { // rare: interpolate the colors, one pixel at a time
+        double area = (double)(e[0] + e[1] + e[2]); // constant over the triangle, up to the bias
+        for (int y = by0; y <= by1; ++y) {
+            long long w[3];
+            for (int i = 0; i < 3; ++i) w[i] = e[i] + (long long)stepY[i] * (y - by0);
+            for (int x = bx0; x <= bx1; ++x) {
+                if (w[0] >= 0 && w[1] >= 0 && w[2] >= 0 && area > 0)
+                    softPlot(tile, x, y, t.z, softLerpColor(t.color, (float)(w[1] / area), (float)(w[2] / area), (float)(w[0] / area)));
+                for (int i = 0; i < 3; ++i) w[i] += stepX[i];
+            }
+        }
+        return;
+    }
+
+    // crossing edges fit in 32 bits: they pass through the box, so they stay
+    // within |stepX| * 67 + |stepY| * 64 of zero, and with coordinates under
+    // SOFT_MAX_COORD both steps are under 2^23, so that is under 2^31
+    __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+    __m128i rowW[3], step4[3];
+    for (int k = 0; k < n; ++k) {
+        int i = crossing[k];
+        rowW[k] = _mm_add_epi32(_mm_set1_epi32((int)e[i]), _mm_set_epi32(3 * stepX[i], 2 * stepX[i], stepX[i], 0));
+        step4[k] = _mm_set1_epi32(4 * stepX[i]);
+    }
+    __m128 z = _mm_set1_ps(t.z);
+    __m128i color = _mm_set1_epi32((int)t.color[0]);
+    int width = bx1 - bx0 + 1;
+    __m128i widthV = _mm_set1_epi32(width);
+    for (int y = by0; y <= by1; ++y) {
+        uint32_t* crow = tile.color + (size_t)(y - tile.oy) * SOFT_TILE_STRIDE + (bx0 - tile.ox);
+        float* drow = tile.depth + (size_t)(y - tile.oy) * SOFT_TILE_STRIDE + (bx0 - tile.ox);
+        __m128i w[3] = { rowW[0], rowW[1], rowW[2] };
+        for (int x = 0; x < width; x += 4) {
+            __m128i outside = _mm_setzero_si128();
+            for (int k = 0; k < n; ++k) {
+                outside = _mm_or_si128(outside, w[k]);
+                w[k] = _mm_add_epi32(w[k], step4[k]);
+            }
+            outside = _mm_srai_epi32(outside, 31); // any edge negative
+            __m128i inRow = _mm_cmplt_epi32(_mm_add_epi32(_mm_set1_epi32(x), lanes), widthV);
+            __m128 d = _mm_loadu_ps(drow + x);
+            __m128i keep = _mm_andnot_si128(outside, _mm_and_si128(inRow, _mm_castps_si128(_mm_cmpge_ps(z, d))));
+            if (_mm_movemask_epi8(keep) == 0) continue;
+            __m128i c = _mm_loadu_si128((const __m128i*)(crow + x));
+            _mm_storeu_si128((__m128i*)(crow + x), _mm_or_si128(_mm_and_si128(keep, color), _mm_andnot_si128(keep, c)));
+            __m128 keepF = _mm_castsi128_ps(keep);
+            _mm_storeu_ps(drow + x, _mm_or_ps(_mm_and_ps(keepF, z), _mm_andnot_ps(keepF, d)));
+        }
+        for (int k = 0; k < n; ++k) rowW[k] = _mm_add_epi32(rowW[k], _mm_set1_epi32(stepY[crossing[k]]));
+    }
+}
+
+// One pixel per column (or row) along the major axis, at the pixel centres
+// from the first endpoint up to, not including, the last
+inline void softLine(const SoftTile& tile, const SoftLine& l) {
+    float dx = l.x1 - l.x0, dy = l.y1 - l.y0;
+    bool xMajor = fabsf(dx) >= fabsf(dy);
+    float a0 = xMajor ? l.x0 : l.y0, a1 = xMajor ? l.x1 : l.y1; // along the major axis
+    float b0 = xMajor ? l.y0 : l.x0, b1 = xMajor ? l.y1 : l.x1;
+    if (a0 == a1) return;
+    if (a0 > a1) { std::swap(a0, a1); std::swap(b0, b1); }
+    float slope = (b1 - b0) / (a1 - a0);
+    int lo = xMajor ? tile.ox : tile.oy, hi = lo + (xMajor ? tile.w : tile.h) - 1;
+    int first = std::max(lo, (int)ceilf(a0 - 0.5f)), last = std::min(hi, (int)ceilf(a1 - 0.5f) - 1);
+    for (int a = first; a <= last; ++a) {
+        float at = b0 + (a + 0.5f - a0) * slope;
+        int b = (int)ceilf(at) - 1; // on a pixel edge: the pixel below (left)
+        int x = xMajor ? a : b, y = xMajor ? b : a;
+        if (x >= tile.ox && x < tile.ox + tile.w && y >= tile.oy && y < tile.oy + tile.h) softPlot(tile, x, y, l.z, l.color);
+    }
+}
+
+inline void softPoint(const SoftTile& tile, const SoftPoint& p) {
+    if (p.size == 1) { softPlot(tile, p.x, p.y, p.z, p.color); return; }
+    int x0 = std::max(p.x, tile.ox), x1 = std::min(p.x + p.size, tile.ox + tile.w);
+    int y0 = std::max(p.y, tile.oy), y1 = std::min(p.y + p.size, tile.oy + tile.h);
+    for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x) softPlot(tile, x, y, p.z, p.color);
+}
+
+inline void softGlyph(const SoftTile& tile, const SoftGlyph& g) {
+    const TextAtlas& t = textAtlas;
+    int x0 = std::max(g.x, tile.ox), x1 = std::min(g.x + g.w, tile.ox + tile.w);
+    int y0 = std::max(g.y, tile.oy), y1 = std::min(g.y + g.h, tile.oy + tile.h);
+    for (int y = y0; y < y1; ++y) {
+        const unsigned char* texels = &t.pixels[(size_t)(y - g.y) * t.texW + g.u - g.x];
+        for (int x = x0; x < x1; ++x)
+            if (texels[x] > 127) softPlot(tile, x, y, g.z, g.color);
+    }
+}
+
+inline void softRasterTile(int index, uint32_t clearColor) {
+    SoftRaster& s = softRaster;
+    static thread_local uint32_t color[SOFT_TILE * SOFT_TILE_STRIDE];
+    static thread_local float depth[SOFT_TILE * SOFT_TILE_STRIDE];
+    SoftTile tile = { color, depth, index % s.tilesX * SOFT_TILE, index / s.tilesX * SOFT_TILE, 0, 0 };
+    tile.w = std::min(SOFT_TILE, s.width - tile.ox);
+    tile.h = std::min(SOFT_TILE, s.height - tile.oy);
+    std::fill(color, color + SOFT_TILE * SOFT_TILE_STRIDE, clearColor);
+    std::fill(depth, depth + SOFT_TILE * SOFT_TILE_STRIDE, -FLT_MAX);
+
+    for (uint32_t entry : s.bins[index]) {
+        uint32_t i = entry & 0x0FFFFFFF;
+        switch (entry >> 28) {
+        case SOFT_TRI: softTriangle(tile, s.tris[i]); break;
+        case SOFT_LINE: softLine(tile, s.lines[i]); break;
+        case SOFT_POINT: softPoint(tile, s.points[i]); break;
+        case SOFT_GLYPH: softGlyph(tile, s.glyphs[i]); break;
+        }
+    }
+    for (int y = 0; y < tile.h; ++y)
+        memcpy(&s.frame[(size_t)(tile.oy + y) * s.width + tile.ox], color + (size_t)y * SOFT_TILE_STRIDE,
+            (size_t)tile.w * sizeof(uint32_t));
+}
+
+// headless.present: rasterize the frame's tiles in parallel, then start the next frame
+inline void softRasterPresent() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    SoftRaster& s = softRaster;
+    float c[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, c);
+    uint32_t clearColor = softPack(batchColorByte(c[0]), batchColorByte(c[1]), batchColorByte(c[2]));
+    s.pool->parallelFor(s.tilesX * s.tilesY, 1, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) softRasterTile(i, clearColor);
+    });
+    s.tris.clear();
+    s.lines.clear();
+    s.points.clear();
+    s.glyphs.clear();
+    for (std::vector<uint32_t>& bin : s.bins) bin.clear();
+    s.frames++;
+    s.rasterMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// headless.readPixels
+inline void softRasterReadPixels(unsigned char* pixels, GLenum format) {
+    const SoftRaster& s = softRaster;
+    if (format == GL_RGBA) {
+        memcpy(pixels, s.frame.data(), s.frame.size() * sizeof(uint32_t));
+        return;
+    }
+    for (uint32_t p : s.frame) {
+        *pixels++ = p & 255;
+        *pixels++ = (p >> 8) & 255;
+        *pixels++ = (p >> 16) & 255;
+    }
+}
+
+// Route the batch, text and headless frame through the software rasterizer
+// for width x height frames; call before headlessInitContext()
+inline void softRasterInit(int width, int height) {
+    SoftRaster& s = softRaster;
+    s.width = width;
+    s.height = height;
+    s.tilesX = (width + SOFT_TILE - 1) / SOFT_TILE;
+    s.tilesY = (height + SOFT_TILE - 1) / SOFT_TILE;
+    s.frame.assign((size_t)width * height, 0);
+    s.bins.assign((size_t)s.tilesX * s.tilesY, std::vector<uint32_t>());
+    s.pool = new ThreadPool(s.threads > 0 ? s.threads : hardwareThreads());
+    batch.backend = softRasterTakeBatch;
+    textAtlas.backend = softRasterTakeText;
+    headless.present = softRasterPresent;
+    headless.readPixels = softRasterReadPixels;
+}
+
+inline void softRasterPrintStats() {
+    const SoftRaster& s = softRaster;
+    if (s.frames == 0) return;
+    printf("soft raster: %dx%d in %d tiles on %d threads, %.3f ms/frame binning, %.3f ms/frame rasterizing, %.1f tile entries/frame\n",
+        s.width, s.height, s.tilesX * s.tilesY, s.pool->size(), s.binMs / s.frames, s.rasterMs / s.frames,
+        (double)s.binEntries / s.frames);
+}
@@ -0,0 +1,105 @@
+// spatial_grid.h
+// Uniform spatial hash over agent positions in [-1, 1] x [-1, 1]. Each cell keeps
+// a list of the agents inside it, and every agent remembers its cell and slot, so
+// moving an agent to another cell is a swap-remove plus a push. After a step only
+// the agents that crossed a cell edge are touched. Range queries visit just the
+// cells overlapping the query's bounding box.
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+struct SpatialGrid {
+    int cellsPerSide = 0;
+    float cellSize = 0;                 // world units per cell
+    std::vector<std::vector<int>> cells;
+    std::vector<int> cellOf;            // cell of each agent, -1 when not indexed
+    std::vector<int> slotOf;            // position of each agent in its cell's list
+};
+
+// Column (or row) of a coordinate; positions just outside [-1, 1] land in the edge cells
+inline int gridColumn(const SpatialGrid& g, float v) {
+    int c = (int)floorf((v + 1.0f) / g.cellSize);
+    if (c < 0) return 0;
+    if (c >= g.cellsPerSide) return g.cellsPerSide - 1;
+    return c;
+}
+
+inline int gridCellAt(const SpatialGrid& g, float x, float y) {
+    return gridColumn(g, y) * g.cellsPerSide + gridColumn(g, x);
+}
+
+inline void gridInsert(SpatialGrid& g, int agent, int cell) {
+    g.cellOf[agent] = cell;
+    g.slotOf[agent] = (int)g.cells[cell].size();
+    g.cells[cell].push_back(agent);
+}
+
+// Drop an agent from the index (it stays out until inserted again)
+inline void gridRemove(SpatialGrid& g, int agent) {
+    int cell = g.cellOf[agent];
+    if (cell < 0) return;
+    std::vector<int>& list = g.cells[cell];
+    int last = list.back();
+    list[g.slotOf[agent]] = last;
+    g.slotOf[last] = g.slotOf[agent];
+    list.pop_back();
+    g.cellOf[agent] = -1;
+}
+
+// Index agents [0, count) from scratch
+inline void gridBuild(SpatialGrid& g, int cellsPerSide, const float* x, const float* y, int count) {
+    g.cellsPerSide = cellsPerSide;
+    g.cellSize = 2.0f / cellsPerSide;
+    g.cells.assign(cellsPerSide * cellsPerSide, std::vector<int>());
+    g.cellOf.assign(count, -1);
+    g.slotOf.assign(count, 0);
+    for (int i = 0; i < count; ++i) gridInsert(g, i, gridCellAt(g, x[i], y[i]));
+}
+
+// Re-bucket indexed agents after they moved; returns how many changed cell
+inline int gridUpdate(SpatialGrid& g, const float* x, const float* y) {
+    int moved = 0;
+    for (int i = 0; i < (int)g.cellOf.size(); ++i) {
+        int old = g.cellOf[i];
+        if (old < 0) continue;
+        int cell = gridCellAt(g, x[i], y[i]);
+        if (cell == old) continue;
+        gridRemove(g, i);
+        gridInsert(g, i, cell);
+        moved++;
+    }
+    return moved;
+}
+
+// Append to `hits` every indexed agent in the cells overlapping the box
+// [minX, maxX] x [minY, maxY] for which inside(agent) holds
+template <class Inside>
+inline void gridQueryBox(const SpatialGrid& g, float minX, float minY, float maxX, float maxY,
+    Inside inside, std::vector<int>& hits) {
+    int x0 = gridColumn(g, minX), x1 = gridColumn(g, maxX);
+    int y0 = gridColumn(g, minY), y1 = gridColumn(g, maxY);
+    for (int j = y0; j <= y1; ++j)
+        for (int i = x0; i <= x1; ++i)
+            for (int agent : g.cells[j * g.cellsPerSide + i])
+                if (inside(agent)) hits.push_back(agent);
+}
+
+// Agents within distance r of (cx, cy)
+inline void gridQueryCircle(const SpatialGrid& g, const float* x, const float* y,
+    float cx, float cy, float r, std::vector<int>& hits) {
+    gridQueryBox(g, cx - r, cy - r, cx + r, cy + r, [&](int i) {
+        float dx = x[i] - cx, dy = y[i] - cy;
+        return dx * dx + dy * dy <= r * r;
+    }, hits);
+}
+
+// Agents inside the axis-aligned ellipse with radii (rx, ry) around (cx, cy)
+inline void gridQueryEllipse(const SpatialGrid& g, const float* x, const float* y,
+    float cx, float cy, float rx, float ry, std::vector<int>& hits) {
+    float sx = 1.0f / rx, sy = 1.0f / ry;
+    gridQueryBox(g, cx - rx, cy - ry, cx + rx, cy + ry, [&](int i) {
+        float ux = (x[i] - cx) * sx, uy = (y[i] - cy) * sy;
+        return ux * ux + uy * uy <= 1.0f;
+    }, hits);
+}
@@ -0,0 +1,189 @@
+// sphere_lod.h
+// Unit sphere tessellated once at a few levels of detail, drawn for a whole
+// layer of neurons per call. The level is picked from the projected screen
+// radius of the layer's nearest neuron; spheres smaller than a couple of pixels
+// become point impostors (the programs draw them unlit, so a sphere is a flat
+// disc on screen anyway).
+//
+// With GL 3.3 a layer is one glDrawArraysInstanced reading the neuron
+// positions straight from the caller's xyz array; otherwise the mesh is
+// expanded on the CPU into the frame batch, like batchDrawInstances().
+#pragma once
+
+#include "render_batch.h"
+#include <cmath>
+#include <vector>
+
+struct SphereLodLevel {
+    int slices, stacks;
+    float minPixels;        // use this level when the projected radius is at least this
+    GLint first = 0;        // offset in the shared vertex buffer
+    GLsizei count = 0;
+};
+
+struct SphereLod {
+    SphereLodLevel levels[3] = { { 20, 20, 12.0f }, { 12, 8, 5.0f }, { 8, 6, 2.0f } };
+    std::vector<float> vertices; // xyz triangles of every level, back to back
+    GLuint vbo = 0;
+    GLuint program = 0;
+    int drawsPerLevel[4] = {};   // layers drawn at each level (3: impostor) this frame
+};
+
+inline SphereLod sphereLod;
+
+const char* const SPHERE_LOD_VS =
+    "#version 120\n"
+    "attribute vec3 pos;\n"
+    "attribute vec3 center;\n"
+    "uniform float radius;\n"
+    "uniform vec4 color;\n"
+    "void main() {\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(center + radius * pos, 1.0);\n"
+    "    gl_FrontColor = color;\n"
+    "}\n";
+const char* const SPHERE_LOD_FS =
+    "#version 120\n"
+    "void main() { gl_FragColor = gl_Color; }\n";
+
+// Point on the unit sphere at stack i (from the south pole) and slice j, laid
+// out the way gluSphere does it
+inline void sphereLodPoint(std::vector<float>& out, int i, int j, int slices, int stacks) {
+    float phi = 3.14159265f * i / stacks - 1.5707963f;
+    float theta = 2.0f * 3.14159265f * (j % slices) / slices;
+    out.push_back(cosf(phi) * sinf(theta));
+    out.push_back(cosf(phi) * cosf(theta));
+    out.push_back(sinf(phi));
+}
+
+inline void sphereLodBuild() {
+    SphereLod& s = sphereLod;
+    s.vertices.clear();
+    for (SphereLodLevel& l : s.levels) {
+        l.first = (GLint)(s.vertices.size() / 3);
+        for (int i = 0; i < l.stacks; ++i) {
+            for (int j = 0; j < l.slices; ++j) {
+                sphereLodPoint(s.vertices, i, j, l.slices, l.stacks);
+                sphereLodPoint(s.vertices, i + 1, j, l.slices, l.stacks);
+                sphereLodPoint(s.vertices, i + 1, j + 1, l.slices, l.stacks);
+                sphereLodPoint(s.vertices, i, j, l.slices, l.stacks);
+                sphereLodPoint(s.vertices, i + 1, j + 1, l.slices, l.stacks);
+                sphereLodPoint(s.vertices, i, j + 1, l.slices, l.stacks);
+            }
+        }
+        l.count = (GLsizei)(s.vertices.size() / 3) - l.first;
+    }
+}
+
+// Instanced program and vertex buffer, made on first use; false when the
+// context can't instance (or batch.instancing was forced off)
+inline bool sphereLodInstancing() {
+    SphereLod& s = sphereLod;
+    if (s.program) return true;
+    if (!batchInstancingAvailable()) return false;
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER), fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(vs, 1, &SPHERE_LOD_VS, nullptr);
+    glShaderSource(fs, 1, &SPHERE_LOD_FS, nullptr);
+    glCompileShader(vs);
+    glCompileShader(fs);
+    GLuint prog = glCreateProgram();
+    glAttachShader(prog, vs);
+    glAttachShader(prog, fs);
+    glBindAttribLocation(prog, 0, "pos");
+    glBindAttribLocation(prog, 1, "center");
+    glLinkProgram(prog);
+    GLint linked = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    if (!linked) { glDeleteProgram(prog); batch.instancing = 0; return false; }
+    s.program = prog;
+    glGenBuffers(1, &s.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, s.vbo);
+    glBufferData(GL_ARRAY_BUFFER, s.vertices.size() * sizeof(float), s.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+// Largest on-screen radius in pixels of a sphere of `radius` at any of the n
+// centres. mvp is column-major; its y row has the projection's y scale as
+// length as long as the modelview has no scaling.
+inline float sphereLodPixelRadius(const float* mvp, float viewportH, const float* xyz, int n, float radius) {
+    float yScale = sqrtf(mvp[1] * mvp[1] + mvp[5] * mvp[5] + mvp[9] * mvp[9]);
+    float nearest = 1e30f;
+    for (int i = 0; i < n; ++i) {
+        const float* p = xyz + 3 * i;
+        float w = mvp[3] * p[0] + mvp[7] * p[1] + mvp[11] * p[2] + mvp[15];
+        if (w > 1e-6f && w < nearest) nearest = w;
+    }
+    return radius * yScale * 0.5f * viewportH / nearest;
+}
+
+// Draw n spheres of one radius and color centred at the xyz triples
+inline void sphereLodDrawLayer(const float* xyz, int n, float radius, float pixelRadius,
+    float r, float g, float b) {
+    SphereLod& s = sphereLod;
+    if (n <= 0) return;
+    if (s.vertices.empty()) sphereLodBuild();
+
+    int level = 3;
+    for (int l = 2; l >= 0; --l)
+        if (pixelRadius >= s.levels[l].minPixels) level = l;
+    s.drawsPerLevel[level]++;
+    batch.stats.instances += n;
+
+    if (level == 3) {
+        // impostor: one point per neuron, as wide as the sphere
+        glPointSize(fmaxf(1.0f, 2.0f * pixelRadius));
+        glColor3f(r, g, b);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(3, GL_FLOAT, 0, xyz);
+        glDrawArrays(GL_POINTS, 0, n);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glPointSize(1.0f);
+        batch.stats.vertices += n;
+        batch.stats.flushes++;
+        return;
+    }
+
+    const SphereLodLevel& l = s.levels[level];
+    if (sphereLodInstancing()) {
+        glUseProgram(s.program);
+        glUniform1f(glGetUniformLocation(s.program, "radius"), radius);
+        glUniform4f(glGetUniformLocation(s.program, "color"), r, g, b, 1.0f);
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glBindBuffer(GL_ARRAY_BUFFER, s.vbo);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (const void*)0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, xyz);
+        glVertexAttribDivisor(1, 1);
+        glDrawArraysInstanced(GL_TRIANGLES, l.first, l.count, n);
+        glVertexAttribDivisor(1, 0);
+        glDisableVertexAttribArray(1);
+        glDisableVertexAttribArray(0);
+        glUseProgram(0);
+        batch.stats.vertices += (long long)l.count * n;
+        batch.stats.flushes++;
+        return;
+    }
+
+    // CPU path: scale and translate the mesh into the frame's triangle list
+    batchColor3f(r, g, b);
+    const float* mesh = &s.vertices[3 * l.first];
+    size_t base = batch.tris.size();
+    batch.tris.resize(base + (size_t)l.count * n);
+    BatchVertex* out = &batch.tris[base];
+    for (int i = 0; i < n; ++i) {
+        const float* c = xyz + 3 * i;
+        for (int v = 0; v < l.count; ++v, ++out) {
+            out->x = c[0] + radius * mesh[3 * v];
+            out->y = c[1] + radius * mesh[3 * v + 1];
+            out->z = c[2] + radius * mesh[3 * v + 2];
+            out->r = batch.color[0]; out->g = batch.color[1]; out->b = batch.color[2]; out->a = batch.color[3];
+        }
+    }
+}
+
+inline void sphereLodBeginFrame() {
+    for (int& d : sphereLod.drawsPerLevel) d = 0;
+}
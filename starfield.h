@@ -0,0 +1,152 @@
+// starfield.h
+// Parallax starfield for Space Exploration, the storyboard's "starfield" hook.
+// Stars lie in a few depth layers: far layers hold most of them, small, dim
+// and slow; near ones few, big, bright and fast. As the rocket climbs, every
+// layer scrolls down by the climb times its speed and wraps round the screen,
+// and each star twinkles on its own phase.
+//
+// A layer keeps its stars as packed arrays (position, brightness, twinkle
+// phase) padded to a multiple of 4. Every frame one SSE pass per layer
+// scrolls, twinkles and colors four stars at a time, culls the ones twinkled
+// below what shows on the night sky, and writes the rest straight into the
+// layer's vertex array, which is drawn as one point draw (batchDrawPoints):
+// one vertex per star drawn.
+//
+// Options: --stars N (default 3000)
+#pragma once
+
+#include "render_batch.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const int STARFIELD_LAYERS = 4;
+const float STARFIELD_TWINKLE_RATE = 0.03f; // twinkles per tick
+const float STARFIELD_CULL = 0.1f;          // stars dimmer than this don't show on the sky
+
+struct StarLayerStyle {
+    float share;                // of the stars
+    float speed;                // scroll per unit of rocket climb
+    float size;                 // pixels
+    float brightness;           // brightest star
+    float twinkle;              // brightness lost at the bottom of a twinkle
+    float tint[3];
+};
+
+const StarLayerStyle STARFIELD_STYLES[STARFIELD_LAYERS] = {
+    { 0.60f, 0.05f, 1.0f, 0.5f, 0.6f, { 0.8f, 0.85f, 1.0f } },
+    { 0.28f, 0.15f, 1.0f, 0.75f, 0.5f, { 1.0f, 1.0f, 1.0f } },
+    { 0.10f, 0.4f, 2.0f, 0.9f, 0.4f, { 1.0f, 0.95f, 0.85f } },
+    { 0.02f, 1.0f, 3.0f, 1.0f, 0.3f, { 1.0f, 1.0f, 1.0f } },
+};
+
+struct StarLayer {
+    int count = 0, padded = 0;  // padding stars are black and always culled
+    std::vector<float> x, y, brightness, phase;
+    std::vector<BatchVertex> vertices; // stars drawn this frame, read at flush
+    int drawn = 0;
+};
+
+struct Starfield {
+    int stars = 3000;           // --stars
+    StarLayer layers[STARFIELD_LAYERS];
+    // statistics
+    long long updates = 0;
+    double updateMs = 0;
+    int drawn = 0;              // last frame
+};
+
+inline bool starfieldParseArg(int argc, char** argv, int& i, Starfield& f) {
+    if (strcmp(argv[i], "--stars") == 0 && i + 1 < argc) { f.stars = atoi(argv[++i]); return true; }
+    return false;
+}
+
+// Scatter f.stars stars over the layers by their shares
+inline void starfieldInit(Starfield& f) {
+    unsigned seed = 777; // the same sky every run
+    auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+    int left = std::max(0, f.stars);
+    for (int l = 0; l < STARFIELD_LAYERS; ++l) {
+        StarLayer& layer = f.layers[l];
+        const StarLayerStyle& style = STARFIELD_STYLES[l];
+        layer.count = l == STARFIELD_LAYERS - 1 ? left : std::min(left, (int)(f.stars * style.share + 0.5f));
+        left -= layer.count;
+        layer.padded = (layer.count + 3) / 4 * 4;
+        for (std::vector<float>* a : { &layer.x, &layer.y, &layer.brightness, &layer.phase }) a->assign(layer.padded, 0.0f);
+        for (int i = 0; i < layer.count; ++i) {
+            layer.x[i] = 2.0f * random() - 1.0f;
+            layer.y[i] = 2.0f * random() - 1.0f;
+            layer.brightness[i] = style.brightness * (0.4f + 0.6f * random());
+            layer.phase[i] = random();
+        }
+        layer.vertices.resize(layer.padded + 4); // every group of four is stored whole, then overwritten
+    }
+}
+
+inline __m128 starFloor(__m128 v) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, v), _mm_set1_ps(1.0f)));
+}
+
+// Scroll, twinkle and cull one layer into its vertices at depth z
+inline void starLayerUpdate(StarLayer& layer, const StarLayerStyle& style, float climb, float tick, float z) {
+    const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), half = _mm_set1_ps(0.5f);
+    const __m128 scroll = _mm_set1_ps(climb * style.speed), turns = _mm_set1_ps(tick * STARFIELD_TWINKLE_RATE);
+    const __m128 twinkle = _mm_set1_ps(4.0f * style.twinkle), cull = _mm_set1_ps(STARFIELD_CULL);
+    const __m128 zs = _mm_set1_ps(z);
+    const __m128 tint[3] = { _mm_set1_ps(255.0f * style.tint[0]), _mm_set1_ps(255.0f * style.tint[1]),
+        _mm_set1_ps(255.0f * style.tint[2]) };
+    const __m128i opaque = _mm_set1_epi32((int)0xFF000000u);
+    BatchVertex* out = layer.vertices.data();
+    BatchVertex* first = out;
+    for (int i = 0; i < layer.padded; i += 4) {
+        // wrapped into [-1, 1)
+        __m128 y = _mm_sub_ps(_mm_loadu_ps(&layer.y[i]), scroll);
+        y = _mm_sub_ps(y, _mm_mul_ps(two, starFloor(_mm_mul_ps(_mm_add_ps(y, one), half))));
+        // twinkle: a parabola over each cycle, dimmest half way
+        __m128 u = _mm_add_ps(_mm_loadu_ps(&layer.phase[i]), turns);
+        __m128 s = _mm_sub_ps(u, starFloor(u));
+        __m128 dip = _mm_mul_ps(twinkle, _mm_mul_ps(s, _mm_sub_ps(one, s)));
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(&layer.brightness[i]), _mm_sub_ps(one, dip));
+        int visible = _mm_movemask_ps(_mm_cmpge_ps(b, cull));
+        if (visible == 0) continue;
+        __m128i color = _mm_or_si128(opaque, _mm_cvtps_epi32(_mm_mul_ps(b, tint[0])));
+        color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(b, tint[1])), 8));
+        color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(b, tint[2])), 16));
+        // four (x, y, z, rgba) vertices
+        __m128 r0 = _mm_loadu_ps(&layer.x[i]), r1 = y, r2 = zs, r3 = _mm_castsi128_ps(color);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(&out->x, r0); out += visible & 1;
+        _mm_storeu_ps(&out->x, r1); out += (visible >> 1) & 1;
+        _mm_storeu_ps(&out->x, r2); out += (visible >> 2) & 1;
+        _mm_storeu_ps(&out->x, r3); out += (visible >> 3) & 1;
+    }
+    layer.drawn = (int)(out - first);
+}
+
+// The sky for the rocket at height `rocketY`: every layer updated and queued
+// as one point draw, far layers first
+inline void starfieldDraw(Starfield& f, float tick, float rocketY) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    f.drawn = 0;
+    for (int l = 0; l < STARFIELD_LAYERS; ++l) {
+        StarLayer& layer = f.layers[l];
+        float z = batch.ordered ? batchNextLayerZ() : 0.0f;
+        starLayerUpdate(layer, STARFIELD_STYLES[l], rocketY, tick, z);
+        batchDrawPoints(layer.vertices.data(), layer.drawn, STARFIELD_STYLES[l].size);
+        f.drawn += layer.drawn;
+    }
+    f.updates++;
+    f.updateMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+inline void starfieldPrintStats(const Starfield& f) {
+    if (f.updates == 0) return;
+    printf("starfield: %d stars in %d layers, %.3f ms/update; last frame %d drawn, %d culled\n", f.stars,
+        STARFIELD_LAYERS, f.updateMs / f.updates, f.drawn, f.stars - f.drawn);
+}
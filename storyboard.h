@@ -0,0 +1,287 @@
+// storyboard.h
+// Scenes as data. A storyboard file (layout in storyboard_format.h, compiled
+// from text by storyboard_compile.h) is memory-mapped when it is opened;
+// only the header and the scene table are read then, so opening costs the
+// same for ten scenes or a thousand. A scene is checked and indexed the first
+// time it is shown and used in place from the mapping after that.
+//
+// Drawing goes through the frame batch like the hand-written scenes did: items
+// in file order, later ones on top, the scene's static items through a layer
+// cache, and dialogue through the text atlas. Hook items call the program's
+// `hook` in their turn, with their name and position.
+#pragma once
+
+#include "storyboard_format.h"
+#include "render_batch.h"
+#include "circle_cache.h"
+#include "text_atlas.h"
+#include "layer_cache.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A scene checked and pointed into the mapping
+struct SbScene {
+    bool valid = false;
+    const SbSceneHeader* header = nullptr;
+    const SbTrack* tracks = nullptr;
+    const SbItem* items = nullptr;
+    const float* floats = nullptr;
+    const char* text = nullptr;
+    const char* name = "";
+    int settleTick = 0;         // running tick after which nothing changes, -1: never
+};
+
+struct Storyboard {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    int sceneCount = 0;
+    const SbSceneEntry* entries = nullptr;
+    std::unordered_map<int, SbScene> scenes; // the ones shown so far
+    // draws hook items (set after opening); the scene's tick is 0 while idle
+    void (*hook)(const char* name, bool running, float tick, float x, float y) = nullptr;
+};
+
+inline void storyboardClose(Storyboard& b) {
+    if (b.data) munmap((void*)b.data, b.size);
+    b = Storyboard();
+}
+
+// Map a compiled storyboard. Only the header and the scene table are checked;
+// each scene is checked when it is first used.
+inline bool storyboardOpen(Storyboard& b, const char* path) {
+    storyboardClose(b);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { fprintf(stderr, "storyboard: cannot open %s\n", path); return false; }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(SbHeader)) {
+        fprintf(stderr, "storyboard: %s is not a storyboard\n", path);
+        close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { fprintf(stderr, "storyboard: cannot map %s\n", path); return false; }
+    b.data = (const unsigned char*)map;
+    b.size = (size_t)st.st_size;
+
+    const SbHeader* h = (const SbHeader*)b.data;
+    if (memcmp(h->magic, STORYBOARD_MAGIC, 4) != 0 || h->version != STORYBOARD_VERSION ||
+        h->sceneCount > (b.size - sizeof(SbHeader)) / sizeof(SbSceneEntry)) {
+        fprintf(stderr, "storyboard: %s is not a version %u storyboard\n", path, STORYBOARD_VERSION);
+        storyboardClose(b);
+        return false;
+    }
+    b.sceneCount = (int)h->sceneCount;
+    b.entries = (const SbSceneEntry*)(b.data + sizeof(SbHeader));
+    return true;
+}
+
+// ---------------- Tracks ----------------
+inline float sbTrackValue(const SbTrack& k, float tick, int copy) {
+    float u = k.rate * tick + k.offset + k.step * copy;
+    switch (k.kind) {
+    case SB_LINEAR: return k.base + k.scale * u;
+    case SB_SIN: return k.base + k.scale * sinf(u);
+    case SB_COS: return k.base + k.scale * cosf(u);
+    case SB_WRAP: return k.base + k.scale * fmodf(u, k.param);
+    case SB_CLAMP: return k.base + k.scale * fminf(k.param, u);
+    default: return k.base;
+    }
+}
+
+// First tick from which the track stays put for copy `copy`, -1 if it never does
+inline int sbTrackSettleTick(const SbTrack& k, int copy) {
+    if (k.kind == SB_CONST || k.rate == 0 || k.scale == 0) return 0;
+    if (k.kind != SB_CLAMP || k.rate < 0) return -1;
+    float start = k.offset + k.step * copy;
+    if (start >= k.param) return 0;
+    return (int)ceilf((k.param - start) / k.rate);
+}
+
+inline int sbLaterTick(int a, int b) {
+    return (a < 0 || b < 0) ? -1 : (a > b ? a : b);
+}
+
+// When the scene stops changing once started: every item that runs is either
+// gone by then (its window ended) or has all its tracks settled
+inline int sbSceneSettleTick(const SbScene& s) {
+    int settle = 0;
+    for (uint32_t i = 0; i < s.header->itemCount; ++i) {
+        const SbItem& it = s.items[i];
+        if (!(it.phases & SB_RUNNING)) continue;
+        int item = it.from;
+        if (it.until != SB_FOREVER) item = it.until;
+        else if (it.type == SB_HOOK) item = -1; // the program's drawing may change on any tick
+        else {
+            const uint16_t refs[6] = { it.x, it.y, it.rx, it.ry, it.angle, it.mix };
+            for (uint16_t r : refs) {
+                if (r == SB_NO_TRACK) continue;
+                int last = it.repeat > 0 ? (int)it.repeat - 1 : 0;
+                item = sbLaterTick(item, sbTrackSettleTick(s.tracks[r], 0));
+                item = sbLaterTick(item, sbTrackSettleTick(s.tracks[r], last));
+            }
+        }
+        settle = sbLaterTick(settle, item);
+    }
+    return settle;
+}
+
+// ---------------- Scenes ----------------
+inline bool sbTrackRefOk(uint16_t r, uint32_t trackCount, bool required) {
+    return r == SB_NO_TRACK ? !required : r < trackCount;
+}
+
+// Point `s` into the scene's bytes and check everything drawing will touch
+inline bool sbParseScene(const Storyboard& b, int index, SbScene& s) {
+    const SbSceneEntry& e = b.entries[index];
+    if (e.offset % 4 || e.size < sizeof(SbSceneHeader) || e.offset > b.size || e.size > b.size - e.offset) return false;
+    const unsigned char* p = b.data + e.offset;
+    const SbSceneHeader* h = (const SbSceneHeader*)p;
+    uint64_t need = sizeof(SbSceneHeader) + (uint64_t)h->trackCount * sizeof(SbTrack) +
+        (uint64_t)h->itemCount * sizeof(SbItem) + (uint64_t)h->floatCount * sizeof(float) + h->textBytes;
+    if (need > e.size || h->trackCount > SB_NO_TRACK || h->staticFirst > h->staticEnd || h->staticEnd > h->itemCount)
+        return false;
+    s.header = h;
+    s.tracks = (const SbTrack*)(p + sizeof(SbSceneHeader));
+    s.items = (const SbItem*)(s.tracks + h->trackCount);
+    s.floats = (const float*)(s.items + h->itemCount);
+    s.text = (const char*)(s.floats + h->floatCount);
+    if (h->textBytes == 0 || s.text[h->textBytes - 1] != '\0' || h->nameOffset >= h->textBytes) return false;
+    s.name = s.text + h->nameOffset;
+    for (uint32_t i = 0; i < h->trackCount; ++i)
+        if (s.tracks[i].kind >= SB_TRACK_KINDS) return false;
+    for (uint32_t i = 0; i < h->itemCount; ++i) {
+        const SbItem& it = s.items[i];
+        bool round = it.type == SB_ELLIPSE || it.type == SB_ARC;
+        if (it.type >= SB_ITEM_TYPES || !sbTrackRefOk(it.x, h->trackCount, true) ||
+            !sbTrackRefOk(it.y, h->trackCount, true) || !sbTrackRefOk(it.rx, h->trackCount, round) ||
+            !sbTrackRefOk(it.ry, h->trackCount, round) || !sbTrackRefOk(it.angle, h->trackCount, false) ||
+            !sbTrackRefOk(it.mix, h->trackCount, false))
+            return false;
+        if (it.type == SB_POLY && (it.count % 2 || it.first > h->floatCount || it.count > h->floatCount - it.first))
+            return false;
+        if ((it.type == SB_TEXT || it.type == SB_HOOK) && (it.first >= h->textBytes || it.count >= h->textBytes - it.first ||
+            s.text[it.first + it.count] != '\0'))
+            return false;
+        if (it.type == SB_ARC && (it.segments < 3 || it.segments > CIRCLE_CACHE_MAX_SEGMENTS || it.points > it.segments + 1))
+            return false;
+    }
+    s.settleTick = sbSceneSettleTick(s);
+    s.valid = true;
+    return true;
+}
+
+// Scene `index` (0-based), checked on first use; nullptr when it is broken
+inline const SbScene* storyboardScene(Storyboard& b, int index) {
+    if (index < 0 || index >= b.sceneCount) return nullptr;
+    auto it = b.scenes.find(index);
+    if (it == b.scenes.end()) {
+        it = b.scenes.emplace(index, SbScene()).first;
+        if (!sbParseScene(b, index, it->second))
+            fprintf(stderr, "storyboard: scene %d is damaged, skipped\n", index + 1);
+    }
+    return it->second.valid ? &it->second : nullptr;
+}
+
+// ---------------- Drawing ----------------
+inline void sbDrawItem(const SbScene& s, const SbItem& it, float tick) {
+    const SbTrack* k = s.tracks;
+    for (uint32_t i = 0; i < it.repeat; ++i) {
+        int copy = (int)i;
+        float x = sbTrackValue(k[it.x], tick, copy) + copy * it.dx;
+        float y = sbTrackValue(k[it.y], tick, copy) + copy * it.dy;
+        float c[4];
+        float m = it.mix != SB_NO_TRACK ? sbTrackValue(k[it.mix], tick, copy) : 0.0f;
+        for (int j = 0; j < 4; ++j) {
+            c[j] = it.mix != SB_NO_TRACK ? it.color[j] * (1 - m) + it.colorTo[j] * m : it.color[j];
+            c[j] += copy * it.colorStep[j];
+        }
+
+        if (it.type == SB_TEXT) {
+            textDraw(s.text + it.first, x, y, batchNextLayerZ(), c[0], c[1], c[2]);
+            continue;
+        }
+        batchColor4f(c[0], c[1], c[2], c[3]);
+        if (it.type == SB_ELLIPSE) {
+            drawEllipse(it.mode, x, y, sbTrackValue(k[it.rx], tick, copy), sbTrackValue(k[it.ry], tick, copy),
+                (int)it.segments);
+        }
+        else if (it.type == SB_ARC) {
+            // the cached n-gon turned by the start angle
+            const float* uc = unitCircle((int)it.segments);
+            float rx = sbTrackValue(k[it.rx], tick, copy), ry = sbTrackValue(k[it.ry], tick, copy);
+            float a = it.angle != SB_NO_TRACK ? sbTrackValue(k[it.angle], tick, copy) : 0.0f;
+            float pc = cosf(a), ps = sinf(a);
+            batchBegin(GL_LINE_STRIP);
+            for (uint32_t p = 0; p < it.points; ++p) {
+                float cs = uc[2 * p] * pc - uc[2 * p + 1] * ps;
+                float sn = uc[2 * p + 1] * pc + uc[2 * p] * ps;
+                batchVertex2f(x + rx * cs, y + ry * sn);
+            }
+            batchEnd();
+        }
+        else {
+            const float* v = s.floats + it.first;
+            if (it.angle != SB_NO_TRACK) {
+                batchPushMatrix();
+                batchTranslatef(x, y);
+                batchRotatef(sbTrackValue(k[it.angle], tick, copy));
+                x = y = 0.0f;
+            }
+            batchBegin(it.mode);
+            for (uint32_t p = 0; p < it.count; p += 2) batchVertex2f(x + v[p], y + v[p + 1]);
+            batchEnd();
+            if (it.angle != SB_NO_TRACK) batchPopMatrix();
+        }
+    }
+}
+
+inline bool sbItemShows(const SbItem& it, bool running, float tick) {
+    return (it.phases & (running ? SB_RUNNING : SB_IDLE)) && tick >= it.from &&
+        (it.until == SB_FOREVER || tick < it.until);
+}
+
+// Draw scene `index` at `tick` (0 while idle; fractional ticks are in-between
+// frames of the windowed clock). The static items go through
+// `cache`, keyed by the scene.
+inline void storyboardDraw(Storyboard& b, int index, bool running, float tick, LayerCache& cache) {
+    const SbScene* s = storyboardScene(b, index);
+    if (!s) return;
+    if (!running) tick = 0;
+    const SbSceneHeader& h = *s->header;
+    for (uint32_t i = 0; i < h.itemCount; ++i) {
+        if (i == h.staticFirst && h.staticFirst < h.staticEnd) {
+            if (layerCacheBegin(cache, index)) {
+                for (uint32_t j = h.staticFirst; j < h.staticEnd; ++j) sbDrawItem(*s, s->items[j], 0);
+                layerCacheEnd(cache);
+            }
+            i = h.staticEnd - 1;
+            continue;
+        }
+        const SbItem& it = s->items[i];
+        if (!sbItemShows(it, running, tick)) continue;
+        if (it.type == SB_HOOK) {
+            if (b.hook)
+                b.hook(s->text + it.first, running, tick, sbTrackValue(s->tracks[it.x], tick, 0),
+                    sbTrackValue(s->tracks[it.y], tick, 0));
+        }
+        else sbDrawItem(*s, it, tick);
+    }
+}
+
+// Running tick after which scene `index` no longer changes, -1 if it animates for ever
+inline int storyboardSettleTick(Storyboard& b, int index) {
+    const SbScene* s = storyboardScene(b, index);
+    return s ? s->settleTick : 0;
+}
+
+inline const char* storyboardSceneName(Storyboard& b, int index) {
+    const SbScene* s = storyboardScene(b, index);
+    return s ? s->name : "";
+}
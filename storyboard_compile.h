@@ -0,0 +1,442 @@
+// storyboard_compile.h
+// Compile a text storyboard into the binary form the storyboard program maps
+// (layout in storyboard_format.h). Used by tools/storyboard_compile and by the
+// story program, which compiles its storyboard on start when the binary is
+// missing or older than the source (storyboardCompileIfStale).
+//
+// Source format, one statement per line, '#' starts a comment:
+//
+//   scene NAME                      starts a scene (shown in the footer)
+//   track NAME KIND ARGS [offset=O] [step=S]
+//       const V | linear BASE SCALE RATE | sin BASE SCALE RATE | cos BASE SCALE RATE
+//       wrap BASE SCALE RATE PERIOD | clamp BASE SCALE RATE MAX
+//       (see storyboard_format.h for how they are evaluated)
+//   static ... end                  items drawn once and cached, at most one block
+//                                   per scene; they cannot move or come and go
+//
+// Items, drawn in order (later on top). X, Y, R, RX, RY are numbers or tracks.
+//   poly MODE X Y VX VY ...         vertices relative to (X, Y)
+//   ellipse MODE X Y RX RY SEGMENTS
+//   circle X Y R                    filled, 64 segments
+//   arc X Y RX RY SEGMENTS POINTS   open outline over POINTS corners of a SEGMENTS-gon
+//   text X Y "TEXT"
+//   hook NAME [X Y]                 drawn by the program, which knows it by NAME and
+//                                   is given X and Y (default 0 0), e.g. to follow a track
+// MODE: points lines line_strip line_loop triangles triangle_strip
+//       triangle_fan quads polygon
+// Item options:
+//   color=R,G,B[,A]                 default black
+//   to=R,G,B[,A] mix=TRACK          blend towards `to` by the track (0..1)
+//   repeat=N dx=DX dy=DY dcolor=R,G,B[,A]   N copies, each shifted by these
+//   angle=TRACK                     poly: rotation in degrees about (X, Y);
+//                                   arc: start angle in radians
+//   when=idle|running               only before / after the scene is started
+//   from=T until=T                  only for ticks T with from <= T < until
+//
+// Errors in the source are reported as FILE:LINE: message and exit.
+#pragma once
+
+#include "storyboard_format.h"
+#include <sys/stat.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// GL primitive enums, to keep the compiler free of GL headers
+static const struct { const char* name; uint32_t mode; } SB_MODES[] = {
+    { "points", 0x0000 }, { "lines", 0x0001 }, { "line_loop", 0x0002 }, { "line_strip", 0x0003 },
+    { "triangles", 0x0004 }, { "triangle_strip", 0x0005 }, { "triangle_fan", 0x0006 },
+    { "quads", 0x0007 }, { "polygon", 0x0009 },
+};
+const uint32_t SB_MODE_POLYGON = 0x0009;
+
+struct SbSceneBuild {
+    std::string name;
+    std::vector<SbTrack> tracks;
+    std::map<std::string, uint16_t> trackNames;
+    std::map<float, uint16_t> constants;
+    std::vector<SbItem> items;
+    std::vector<float> floats;
+    std::string text;
+    int staticFirst = -1, staticEnd = -1;
+};
+
+inline const char* sbSourcePath;
+inline int sbLineNumber;
+
+inline void sbFail(const char* message, const std::string& detail = "") {
+    fprintf(stderr, "%s:%d: %s%s%s\n", sbSourcePath, sbLineNumber, message, detail.empty() ? "" : ": ", detail.c_str());
+    exit(1);
+}
+
+// Split a line into words; "quoted text" is one word (without the quotes)
+inline std::vector<std::string> sbTokenize(const std::string& line, std::vector<bool>& quoted) {
+    std::vector<std::string> words;
+    quoted.clear();
+    size_t i = 0;
+    while (i < line.size()) {
+        if (isspace((unsigned char)line[i])) { i++; continue; }
+        if (line[i] == '#') break;
+        if (line[i] == '"') {
+            size_t end = line.find('"', i + 1);
+            if (end == std::string::npos) sbFail("unterminated string");
+            words.push_back(line.substr(i + 1, end - i - 1));
+            quoted.push_back(true);
+            i = end + 1;
+            continue;
+        }
+        size_t end = i;
+        while (end < line.size() && !isspace((unsigned char)line[end])) end++;
+        words.push_back(line.substr(i, end - i));
+        quoted.push_back(false);
+        i = end;
+    }
+    return words;
+}
+
+inline bool sbParseFloat(const std::string& s, float& out) {
+    char* end;
+    out = strtof(s.c_str(), &end);
+    return !s.empty() && *end == '\0';
+}
+
+inline float sbNumber(const std::string& s) {
+    float v;
+    if (!sbParseFloat(s, v)) sbFail("expected a number", s);
+    return v;
+}
+
+inline int sbInteger(const std::string& s) {
+    float v = sbNumber(s);
+    if (v != floorf(v)) sbFail("expected a whole number", s);
+    return (int)v;
+}
+
+// R,G,B[,A]
+inline void sbColor(const std::string& s, float* out, float alpha) {
+    float c[4] = { 0, 0, 0, alpha };
+    int n = 0;
+    size_t start = 0;
+    while (n < 4) {
+        size_t comma = s.find(',', start);
+        c[n++] = sbNumber(s.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    if (n < 3) sbFail("expected R,G,B or R,G,B,A", s);
+    memcpy(out, c, sizeof(c));
+}
+
+inline uint16_t sbAddTrack(SbSceneBuild& scene, const SbTrack& t) {
+    if (scene.tracks.size() >= SB_NO_TRACK) sbFail("too many tracks in the scene");
+    scene.tracks.push_back(t);
+    return (uint16_t)(scene.tracks.size() - 1);
+}
+
+// A number (as a constant track) or the name of a track
+inline uint16_t sbValue(SbSceneBuild& scene, const std::string& s) {
+    float v;
+    if (sbParseFloat(s, v)) {
+        auto it = scene.constants.find(v);
+        if (it != scene.constants.end()) return it->second;
+        SbTrack t = { SB_CONST, v, 0, 0, 0, 0, 0 };
+        return scene.constants[v] = sbAddTrack(scene, t);
+    }
+    auto it = scene.trackNames.find(s);
+    if (it == scene.trackNames.end()) sbFail("unknown track", s);
+    return it->second;
+}
+
+inline bool sbIsAnimated(const SbSceneBuild& scene, uint16_t track) {
+    return track != SB_NO_TRACK && scene.tracks[track].kind != SB_CONST;
+}
+
+inline void sbParseTrack(SbSceneBuild& scene, const std::vector<std::string>& w) {
+    if (w.size() < 4) sbFail("track needs a name, a kind and values");
+    if (scene.trackNames.count(w[1])) sbFail("track defined twice", w[1]);
+    float dummy;
+    if (sbParseFloat(w[1], dummy)) sbFail("track names cannot be numbers", w[1]);
+    static const struct { const char* name; SbTrackKind kind; size_t args; } KINDS[] = {
+        { "const", SB_CONST, 1 }, { "linear", SB_LINEAR, 3 }, { "sin", SB_SIN, 3 },
+        { "cos", SB_COS, 3 }, { "wrap", SB_WRAP, 4 }, { "clamp", SB_CLAMP, 4 },
+    };
+    SbTrack t = { SB_CONST, 0, 1, 0, 0, 0, 0 };
+    size_t args = 0;
+    bool known = false;
+    for (const auto& k : KINDS)
+        if (w[2] == k.name) { t.kind = k.kind; args = k.args; known = true; }
+    if (!known) sbFail("unknown track kind", w[2]);
+    size_t i = 3;
+    for (size_t a = 0; a < args; ++a, ++i) {
+        if (i >= w.size() || w[i].find('=') != std::string::npos) sbFail("too few values for track", w[2]);
+        float v = sbNumber(w[i]);
+        if (a == 0) t.base = v;
+        else if (a == 1) t.scale = v;
+        else if (a == 2) t.rate = v;
+        else t.param = v;
+    }
+    for (; i < w.size(); ++i) {
+        size_t eq = w[i].find('=');
+        std::string key = w[i].substr(0, eq), val = eq == std::string::npos ? "" : w[i].substr(eq + 1);
+        if (key == "offset") t.offset = sbNumber(val);
+        else if (key == "step") t.step = sbNumber(val);
+        else sbFail("unknown track option", w[i]);
+    }
+    if (t.kind == SB_WRAP && t.param <= 0) sbFail("wrap needs a positive period");
+    scene.trackNames[w[1]] = sbAddTrack(scene, t);
+}
+
+inline uint32_t sbParseMode(const std::string& s) {
+    for (const auto& m : SB_MODES)
+        if (s == m.name) return m.mode;
+    sbFail("unknown primitive mode", s);
+    return 0;
+}
+
+inline void sbParseItem(SbSceneBuild& scene, const std::vector<std::string>& w, const std::vector<bool>& quoted,
+    bool inStatic) {
+    SbItem it;
+    memset(&it, 0, sizeof(it));
+    it.phases = SB_IDLE | SB_RUNNING;
+    it.until = SB_FOREVER;
+    it.repeat = 1;
+    it.rx = it.ry = it.angle = it.mix = SB_NO_TRACK;
+    it.color[3] = 1.0f;
+
+    const std::string& kind = w[0];
+    size_t i = 1;
+    auto need = [&](size_t n) { if (i + n > w.size()) sbFail("too few values for", kind); };
+    if (kind == "poly") {
+        need(3);
+        it.type = SB_POLY;
+        it.mode = sbParseMode(w[i++]);
+        it.x = sbValue(scene, w[i++]);
+        it.y = sbValue(scene, w[i++]);
+        it.first = (uint32_t)scene.floats.size();
+        float v;
+        for (; i < w.size() && w[i].find('=') == std::string::npos; ++i) {
+            if (!sbParseFloat(w[i], v)) sbFail("expected a vertex coordinate", w[i]);
+            scene.floats.push_back(v);
+        }
+        it.count = (uint32_t)scene.floats.size() - it.first;
+        if (it.count == 0 || it.count % 2) sbFail("poly needs x y pairs");
+    }
+    else if (kind == "ellipse" || kind == "circle") {
+        it.type = SB_ELLIPSE;
+        if (kind == "circle") {
+            need(3);
+            it.mode = SB_MODE_POLYGON;
+            it.x = sbValue(scene, w[i++]);
+            it.y = sbValue(scene, w[i++]);
+            it.rx = it.ry = sbValue(scene, w[i++]);
+            it.segments = 64;
+        }
+        else {
+            need(6);
+            it.mode = sbParseMode(w[i++]);
+            it.x = sbValue(scene, w[i++]);
+            it.y = sbValue(scene, w[i++]);
+            it.rx = sbValue(scene, w[i++]);
+            it.ry = sbValue(scene, w[i++]);
+            it.segments = sbInteger(w[i++]);
+        }
+        if (it.segments < 3 || it.segments > 1024) sbFail("segments must be 3..1024");
+    }
+    else if (kind == "arc") {
+        need(6);
+        it.type = SB_ARC;
+        it.x = sbValue(scene, w[i++]);
+        it.y = sbValue(scene, w[i++]);
+        it.rx = sbValue(scene, w[i++]);
+        it.ry = sbValue(scene, w[i++]);
+        it.segments = sbInteger(w[i++]);
+        it.points = sbInteger(w[i++]);
+        if (it.segments < 3 || it.segments > 1024) sbFail("segments must be 3..1024");
+        if (it.points < 2 || it.points > it.segments + 1) sbFail("points must be 2..segments+1");
+    }
+    else if (kind == "text") {
+        need(3);
+        it.type = SB_TEXT;
+        it.x = sbValue(scene, w[i++]);
+        it.y = sbValue(scene, w[i++]);
+        if (!quoted[i]) sbFail("text needs a \"quoted\" string");
+        it.first = (uint32_t)scene.text.size();
+        it.count = (uint32_t)w[i].size();
+        scene.text += w[i++];
+        scene.text += '\0';
+    }
+    else if (kind == "hook") {
+        need(1);
+        if (inStatic) sbFail("hooks cannot be static");
+        it.type = SB_HOOK;
+        it.first = (uint32_t)scene.text.size();
+        it.count = (uint32_t)w[i].size();
+        scene.text += w[i++];
+        scene.text += '\0';
+        bool at = i + 1 < w.size() && w[i].find('=') == std::string::npos;
+        it.x = sbValue(scene, at ? w[i++] : "0");
+        it.y = sbValue(scene, at ? w[i++] : "0");
+    }
+    else sbFail("unknown statement", kind);
+
+    bool hasTo = false;
+    for (; i < w.size(); ++i) {
+        size_t eq = w[i].find('=');
+        if (eq == std::string::npos) sbFail("expected key=value", w[i]);
+        std::string key = w[i].substr(0, eq), val = w[i].substr(eq + 1);
+        if (key == "color") sbColor(val, it.color, 1.0f);
+        else if (key == "to") { sbColor(val, it.colorTo, 1.0f); hasTo = true; }
+        else if (key == "dcolor") sbColor(val, it.colorStep, 0.0f);
+        else if (key == "mix") it.mix = sbValue(scene, val);
+        else if (key == "angle") it.angle = sbValue(scene, val);
+        else if (key == "repeat") {
+            int n = sbInteger(val);
+            if (n < 1) sbFail("repeat must be at least 1");
+            it.repeat = n;
+        }
+        else if (key == "dx") it.dx = sbNumber(val);
+        else if (key == "dy") it.dy = sbNumber(val);
+        else if (key == "from") it.from = sbInteger(val);
+        else if (key == "until") it.until = sbInteger(val);
+        else if (key == "when") {
+            if (val == "idle") it.phases = SB_IDLE;
+            else if (val == "running") it.phases = SB_RUNNING;
+            else sbFail("when must be idle or running", val);
+        }
+        else sbFail("unknown option", key);
+    }
+    if (it.mix != SB_NO_TRACK && !hasTo) sbFail("mix needs a to= color");
+    if (it.from < 0 || (it.until != SB_FOREVER && it.until <= it.from)) sbFail("empty from/until window");
+    if (it.type == SB_ARC && it.angle == SB_NO_TRACK) it.angle = sbValue(scene, "0");
+    if (inStatic) {
+        const uint16_t refs[6] = { it.x, it.y, it.rx, it.ry, it.angle, it.mix };
+        for (uint16_t r : refs)
+            if (sbIsAnimated(scene, r)) sbFail("static items cannot use animated tracks");
+        if (it.phases != (SB_IDLE | SB_RUNNING) || it.from != 0 || it.until != SB_FOREVER)
+            sbFail("static items are always shown");
+    }
+    scene.items.push_back(it);
+}
+
+inline void sbPad4(std::string& out) {
+    while (out.size() % 4) out += '\0';
+}
+
+inline void sbAppend(std::string& out, const void* p, size_t n) {
+    out.append((const char*)p, n);
+}
+
+inline std::string sbSceneBytes(SbSceneBuild& s) {
+    SbSceneHeader h;
+    memset(&h, 0, sizeof(h));
+    h.nameOffset = (uint32_t)s.text.size();
+    s.text += s.name;
+    s.text += '\0';
+    h.trackCount = (uint32_t)s.tracks.size();
+    h.itemCount = (uint32_t)s.items.size();
+    h.floatCount = (uint32_t)s.floats.size();
+    h.textBytes = (uint32_t)s.text.size();
+    if (s.staticFirst >= 0) {
+        h.staticFirst = (uint32_t)s.staticFirst;
+        h.staticEnd = (uint32_t)s.staticEnd;
+    }
+    std::string out;
+    sbAppend(out, &h, sizeof(h));
+    sbAppend(out, s.tracks.data(), s.tracks.size() * sizeof(SbTrack));
+    sbAppend(out, s.items.data(), s.items.size() * sizeof(SbItem));
+    sbAppend(out, s.floats.data(), s.floats.size() * sizeof(float));
+    out += s.text;
+    sbPad4(out);
+    return out;
+}
+
+// Compile sourcePath into outPath
+inline bool storyboardCompile(const char* sourcePath, const char* outPath) {
+    sbSourcePath = sourcePath;
+    sbLineNumber = 0;
+    FILE* in = fopen(sbSourcePath, "r");
+    if (!in) { fprintf(stderr, "cannot read %s\n", sbSourcePath); return false; }
+
+    std::vector<SbSceneBuild> scenes;
+    bool inStatic = false;
+    char buf[4096];
+    std::vector<bool> quoted;
+    while (fgets(buf, sizeof(buf), in)) {
+        sbLineNumber++;
+        std::string line(buf);
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        std::vector<std::string> w = sbTokenize(line, quoted);
+        if (w.empty()) continue;
+        if (w[0] == "scene") {
+            if (inStatic) sbFail("static block not closed before the next scene");
+            size_t at = line.find("scene") + 5;
+            std::string name = line.substr(at);
+            size_t comment = name.find('#');
+            if (comment != std::string::npos) name.erase(comment);
+            name.erase(0, name.find_first_not_of(" \t"));
+            name.erase(name.find_last_not_of(" \t") + 1);
+            scenes.push_back(SbSceneBuild());
+            scenes.back().name = name;
+            continue;
+        }
+        if (scenes.empty()) sbFail("statement before the first scene");
+        SbSceneBuild& scene = scenes.back();
+        if (w[0] == "track") sbParseTrack(scene, w);
+        else if (w[0] == "static") {
+            if (inStatic || scene.staticFirst >= 0) sbFail("one static block per scene");
+            inStatic = true;
+            scene.staticFirst = (int)scene.items.size();
+        }
+        else if (w[0] == "end") {
+            if (!inStatic) sbFail("end without static");
+            inStatic = false;
+            scene.staticEnd = (int)scene.items.size();
+        }
+        else sbParseItem(scene, w, quoted, inStatic);
+    }
+    fclose(in);
+    if (inStatic) sbFail("static block not closed");
+    if (scenes.empty()) sbFail("no scenes");
+
+    std::string body;
+    std::vector<SbSceneEntry> entries(scenes.size());
+    size_t headerBytes = sizeof(SbHeader) + scenes.size() * sizeof(SbSceneEntry);
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        std::string bytes = sbSceneBytes(scenes[i]);
+        entries[i].offset = (uint32_t)(headerBytes + body.size());
+        entries[i].size = (uint32_t)bytes.size();
+        body += bytes;
+    }
+    SbHeader h;
+    memcpy(h.magic, STORYBOARD_MAGIC, 4);
+    h.version = STORYBOARD_VERSION;
+    h.sceneCount = (uint32_t)scenes.size();
+    h.reserved = 0;
+
+    FILE* out = fopen(outPath, "wb");
+    if (!out) { fprintf(stderr, "cannot write %s\n", outPath); return false; }
+    fwrite(&h, sizeof(h), 1, out);
+    fwrite(entries.data(), sizeof(SbSceneEntry), entries.size(), out);
+    fwrite(body.data(), 1, body.size(), out);
+    fclose(out);
+    printf("%s: %zu scenes, %zu bytes\n", outPath, scenes.size(), headerBytes + body.size());
+    return true;
+}
+
+// Recompile a storyboard from the .txt beside it (same name) when the
+// storyboard is missing or older; a storyboard without a source is left alone
+inline bool storyboardCompileIfStale(const char* path) {
+    std::string source(path);
+    size_t dot = source.rfind('.');
+    if (dot == std::string::npos || source.find('/', dot) != std::string::npos) return true;
+    source.replace(dot, std::string::npos, ".txt");
+    struct stat src, bin;
+    if (stat(source.c_str(), &src) != 0) return true;
+    if (stat(path, &bin) == 0 && (bin.st_mtim.tv_sec > src.st_mtim.tv_sec ||
+        (bin.st_mtim.tv_sec == src.st_mtim.tv_sec && bin.st_mtim.tv_nsec >= src.st_mtim.tv_nsec))) return true;
+    return storyboardCompile(source.c_str(), path);
+}
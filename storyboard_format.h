@@ -0,0 +1,93 @@
+// storyboard_format.h
+// Binary storyboard layout, shared by the loader (storyboard.h) and the
+// compiler (storyboard_compile.h). No GL here.
+//
+// A file is a header, a table with the offset and size of every scene, then
+// the scenes. Each scene is self-contained and made only of 4-byte fields, so
+// a loader can map the file and use a scene in place the first time it is
+// shown, without touching the others:
+//
+//   SbSceneHeader
+//   SbTrack[trackCount]    animation tracks
+//   SbItem[itemCount]      shapes and dialogue, in drawing order
+//   float[floatCount]      polygon vertices (x, y pairs)
+//   char[textBytes]        scene name and dialogue, each NUL-terminated
+//
+// Every numeric item parameter that can move (position, radius, rotation,
+// color blend) refers to a track; fixed values are constant tracks. A track is
+// evaluated at the scene's tick t for copy i of a repeated item:
+//   u = rate * t + offset + step * i
+//   const: base          linear: base + scale * u
+//   sin:   base + scale * sin(u)              cos: base + scale * cos(u)
+//   wrap:  base + scale * fmod(u, param)      clamp: base + scale * min(param, u)
+// Scenes are still pictures at tick 0 until started; items can be limited to
+// the idle or running phase and to a tick window. A hook item hands its place
+// in the drawing order to the program, by name, for what data cannot describe.
+#pragma once
+
+#include <cstdint>
+
+const char STORYBOARD_MAGIC[4] = { 'S', 'T', 'B', 'D' };
+const uint32_t STORYBOARD_VERSION = 1;
+
+struct SbHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t sceneCount;
+    uint32_t reserved;
+};
+
+struct SbSceneEntry {
+    uint32_t offset, size;      // from the start of the file
+};
+
+struct SbSceneHeader {
+    uint32_t trackCount, itemCount, floatCount, textBytes;
+    uint32_t staticFirst, staticEnd; // items drawn once and cached (empty when equal)
+    uint32_t nameOffset;        // into the scene's text
+    uint32_t reserved;
+};
+
+enum SbTrackKind : uint32_t {
+    SB_CONST, SB_LINEAR, SB_SIN, SB_COS, SB_WRAP, SB_CLAMP, SB_TRACK_KINDS
+};
+
+struct SbTrack {
+    uint32_t kind;
+    float base, scale, rate, offset, step;
+    float param;                // wrap: period, clamp: maximum
+};
+
+enum SbItemType : uint32_t {
+    SB_POLY,                    // vertices relative to (x, y), rotated by angle (degrees)
+    SB_ELLIPSE,                 // drawEllipse(mode, x, y, rx, ry, segments)
+    SB_ARC,                     // line strip over `points` corners of a segments-gon, from angle (radians)
+    SB_TEXT,                    // dialogue at (x, y)
+    SB_HOOK,                    // drawn by the program: Storyboard::hook with the name in the text and (x, y)
+    SB_ITEM_TYPES
+};
+
+// Phases an item shows in
+const uint32_t SB_IDLE = 1, SB_RUNNING = 2;
+// Unused track reference / open-ended tick window
+const uint16_t SB_NO_TRACK = 0xFFFF;
+const int32_t SB_FOREVER = -1;
+
+struct SbItem {
+    uint32_t type;
+    uint32_t mode;              // GL primitive for polygons and ellipses
+    uint32_t phases;            // SB_IDLE | SB_RUNNING
+    int32_t from, until;        // ticks it shows in: from <= t < until (SB_FOREVER: no end)
+    uint32_t repeat;            // copies, each offset by (dx, dy) and colorStep
+    uint32_t segments;          // ellipse and arc tessellation
+    uint32_t points;            // arc corners drawn
+    uint16_t x, y, rx, ry, angle, mix; // tracks
+    float dx, dy;
+    float color[4];             // color at mix 0
+    float colorTo[4];           // color at mix 1
+    float colorStep[4];         // added per copy
+    uint32_t first, count;      // polygon: into the floats; text and hook: into the text
+};
+
+static_assert(sizeof(SbTrack) == 28, "storyboard tracks are 28 bytes");
+static_assert(sizeof(SbItem) == 108, "storyboard items are 108 bytes");
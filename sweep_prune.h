@@ -0,0 +1,70 @@
+// sweep_prune.h
+// Sort-and-sweep broad phase over axis-aligned boxes. The boxes are kept in an
+// order sorted by their left edge. Between frames they only move a little, so
+// the order is repaired with an insertion sort, which on an almost sorted
+// array is one pass plus one move per box that overtook another. The sweep
+// then walks the order once, testing each box only against the boxes whose
+// left edge lies before its right edge, and collects the pairs that overlap on
+// both axes. Touching boxes don't overlap.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+struct SweepPair {
+    int a, b;                   // a < b
+};
+
+struct SweepAndPrune {
+    std::vector<int> order;     // box indices by left edge
+    std::vector<SweepPair> pairs; // overlapping boxes at the last update
+    // statistics
+    long long updates = 0, moves = 0, tests = 0;
+    double ms = 0;
+};
+
+// Re-sort the boxes and find every overlapping pair. A change in the number of
+// boxes starts the order over.
+inline void sweepUpdate(SweepAndPrune& s, const float* minX, const float* maxX, const float* minY,
+    const float* maxY, int count) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    std::vector<int>& order = s.order;
+    if ((int)order.size() != count) {
+        order.resize(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return minX[a] < minX[b]; });
+    }
+    for (int i = 1; i < count; ++i) {
+        int box = order[i];
+        float key = minX[box];
+        int j = i - 1;
+        for (; j >= 0 && minX[order[j]] > key; --j) order[j + 1] = order[j];
+        s.moves += i - 1 - j;
+        order[j + 1] = box;
+    }
+
+    s.pairs.clear();
+    for (int i = 0; i < count; ++i) {
+        int a = order[i];
+        float right = maxX[a], bottom = minY[a], top = maxY[a];
+        for (int j = i + 1; j < count; ++j) {
+            int b = order[j];
+            if (minX[b] >= right) break;
+            s.tests++;
+            if (minY[b] < top && bottom < maxY[b]) s.pairs.push_back({ std::min(a, b), std::max(a, b) });
+        }
+    }
+    s.updates++;
+    s.ms += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+inline void sweepPrintStats(const char* name, const SweepAndPrune& s) {
+    if (s.updates == 0) return;
+    printf("sweep and prune %s: %zu boxes, %.3f ms/update, %.1f moves/update, %.1f box tests/update, %zu pairs last\n",
+        name, s.order.size(), s.ms / s.updates, (double)s.moves / s.updates, (double)s.tests / s.updates,
+        s.pairs.size());
+}
@@ -0,0 +1,207 @@
+// text_atlas.h
+// Text drawn from a glyph atlas instead of one glBitmap per character. The
+// embedded Helvetica 18 glyphs are rasterized into a single alpha texture the
+// first time text is drawn, each distinct string is laid out into glyph quads
+// once and cached, and every string of the frame goes out in one textured
+// draw in textFlush().
+//
+// Placement matches glRasterPos + glBitmap exactly: the string starts at the
+// window pixel its raster position falls in, glyphs are whole texels under
+// GL_NEAREST, and each quad keeps the raster position's depth, so text stays
+// in painter's order with the depth-layered batch.
+#pragma once
+
+#include "bitmap_font.h"
+#include <GL/gl.h>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Glyphs of one string relative to its pen position, in pixels
+struct TextLayout {
+    std::vector<short> x;   // left edge of each glyph
+    std::vector<unsigned char> glyph; // index into the atlas (character - 32)
+    int width = 0;
+};
+
+struct TextVertex {
+    float x, y, z;
+    float u, v;
+    unsigned char r, g, b, a;
+};
+
+struct TextAtlas {
+    GLuint texture = 0;
+    int texW = 0, texH = 0;
+    std::vector<unsigned char> pixels; // the texture's texels, for software backends
+    short glyphX[95];           // left texel column of each glyph in the atlas
+    std::unordered_map<std::string, TextLayout> layouts;
+    std::vector<TextVertex> vertices; // quads queued this frame
+    bool haveView = false;      // matrices captured this frame
+    float mvp[16];
+    int viewport[4];
+    void (*backend)() = nullptr; // takes the queued quads instead of GL when set (soft_raster.h)
+};
+
+inline TextAtlas textAtlas;
+
+// Most layouts kept; the cache starts over when a program keeps making new strings
+const size_t TEXT_LAYOUT_CACHE_MAX = 1024;
+
+// Rasterize all 95 glyphs side by side into one GL_ALPHA texture
+inline void textBuildAtlas() {
+    TextAtlas& t = textAtlas;
+    int total = 0;
+    for (int c = 0; c < 95; ++c) { t.glyphX[c] = (short)total; total += fontGlyphWidth[c]; }
+    t.texW = 1;
+    while (t.texW < total) t.texW *= 2;
+    t.texH = 32;
+    std::vector<unsigned char>& pixels = t.pixels;
+    pixels.assign((size_t)t.texW * t.texH, 0);
+    for (int c = 0; c < 95; ++c) {
+        int w = fontGlyphWidth[c], rowBytes = (w + 7) / 8;
+        const unsigned char* bits = fontGlyphBits + fontGlyphOffset[c];
+        for (int row = 0; row < FONT_HEIGHT; ++row)
+            for (int col = 0; col < w; ++col)
+                if (bits[row * rowBytes + col / 8] & (0x80 >> (col % 8)))
+                    pixels[(size_t)row * t.texW + t.glyphX[c] + col] = 255;
+    }
+    glGenTextures(1, &t.texture);
+    glBindTexture(GL_TEXTURE_2D, t.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, t.texW, t.texH, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Cached layout of s (built on first use)
+inline const TextLayout& textLayout(const char* s) {
+    TextAtlas& t = textAtlas;
+    static std::string key; // reused so lookups don't allocate
+    key.assign(s);
+    auto it = t.layouts.find(key);
+    if (it != t.layouts.end()) return it->second;
+    if (t.layouts.size() >= TEXT_LAYOUT_CACHE_MAX) t.layouts.clear();
+    TextLayout& layout = t.layouts[key];
+    for (int i = 0; s[i]; ++i) {
+        int w;
+        if (!fontGlyph((unsigned char)s[i], &w)) continue;
+        layout.x.push_back((short)layout.width);
+        layout.glyph.push_back((unsigned char)(s[i] - 32));
+        layout.width += w;
+    }
+    return layout;
+}
+
+// Queue a string with its pen at window pixel (x, y) and window depth z in
+// the units of glOrtho(..., -1, 1), i.e. z = -(normalized device z)
+inline void textQueue(const char* s, float x, float y, float z, float r, float g, float b) {
+    TextAtlas& t = textAtlas;
+    if (!t.texture) textBuildAtlas(); // texture coordinates need the atlas size
+    const TextLayout& layout = textLayout(s);
+    unsigned char cr = (unsigned char)(r * 255.0f + 0.5f), cg = (unsigned char)(g * 255.0f + 0.5f),
+        cb = (unsigned char)(b * 255.0f + 0.5f);
+    // a raster position a hair under a pixel edge from float round-off counts as on it
+    float x0 = floorf(x - FONT_XORIG + 1.0f / 64), y0 = floorf(y - FONT_YORIG + 1.0f / 64);
+    float v1 = (float)FONT_HEIGHT / t.texH;
+    for (size_t i = 0; i < layout.glyph.size(); ++i) {
+        int c = layout.glyph[i];
+        float left = x0 + layout.x[i], right = left + fontGlyphWidth[c];
+        float u0 = (float)t.glyphX[c] / t.texW, u1 = (float)(t.glyphX[c] + fontGlyphWidth[c]) / t.texW;
+        TextVertex q[4] = {
+            { left, y0, z, u0, 0.0f, cr, cg, cb, 255 },
+            { right, y0, z, u1, 0.0f, cr, cg, cb, 255 },
+            { right, y0 + FONT_HEIGHT, z, u1, v1, cr, cg, cb, 255 },
+            { left, y0 + FONT_HEIGHT, z, u0, v1, cr, cg, cb, 255 },
+        };
+        t.vertices.insert(t.vertices.end(), q, q + 4);
+    }
+}
+
+// Draw s at a window position in pixels from the viewport's lower-left corner
+// (like glRasterPos2i under gluOrtho2D(0, w, 0, h))
+inline void textDrawWindow(const char* s, float x, float y, float r, float g, float b) {
+    textQueue(s, x, y, 0.0f, r, g, b);
+}
+
+// Draw s at a point of the current modelview/projection (like glRasterPos3f).
+// The matrices are read once per frame, so they must not change between text
+// calls. Nothing is drawn when the point is clipped, as with an invalid
+// raster position.
+inline void textDraw(const char* s, float x, float y, float z, float r, float g, float b) {
+    TextAtlas& t = textAtlas;
+    if (!t.haveView) {
+        float mv[16], proj[16];
+        glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+        glGetFloatv(GL_PROJECTION_MATRIX, proj);
+        glGetIntegerv(GL_VIEWPORT, t.viewport);
+        for (int col = 0; col < 4; ++col)
+            for (int row = 0; row < 4; ++row) {
+                float sum = 0;
+                for (int k = 0; k < 4; ++k) sum += proj[k * 4 + row] * mv[col * 4 + k];
+                t.mvp[col * 4 + row] = sum;
+            }
+        t.haveView = true;
+    }
+    const float* m = t.mvp;
+    float cx = m[0] * x + m[4] * y + m[8] * z + m[12];
+    float cy = m[1] * x + m[5] * y + m[9] * z + m[13];
+    float cz = m[2] * x + m[6] * y + m[10] * z + m[14];
+    float cw = m[3] * x + m[7] * y + m[11] * z + m[15];
+    if (cw <= 0 || fabsf(cx) > cw || fabsf(cy) > cw || fabsf(cz) > cw) return;
+    float wx = (cx / cw + 1.0f) * 0.5f * t.viewport[2];
+    float wy = (cy / cw + 1.0f) * 0.5f * t.viewport[3];
+    textQueue(s, wx, wy, -cz / cw, r, g, b);
+}
+
+// Draw every string queued this frame in one call; call after batchFlush()
+inline void textFlush() {
+    TextAtlas& t = textAtlas;
+    t.haveView = false;
+    if (t.vertices.empty()) return;
+    if (t.backend) {
+        t.backend();
+        t.vertices.clear();
+        return;
+    }
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT | GL_TRANSFORM_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glOrtho(0, viewport[2], 0, viewport[3], -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, t.texture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_ALPHA_TEST); // glyph texels are either on or off, so no blending
+    glAlphaFunc(GL_GREATER, 0.5f);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(TextVertex), &t.vertices[0].x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(TextVertex), &t.vertices[0].u);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &t.vertices[0].r);
+    glDrawArrays(GL_QUADS, 0, (GLsizei)t.vertices.size());
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glPopAttrib();
+
+    t.vertices.clear();
+}
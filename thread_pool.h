@@ -0,0 +1,95 @@
+// thread_pool.h
+// Small fixed-size worker pool with a blocking parallel-for. The calling thread
+// works on chunks too, so a pool of N threads uses N - 1 workers.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;               // guards the job fields below
+    std::mutex submit;              // one parallelFor at a time
+    std::condition_variable wake, done;
+    const std::function<void(int, int)>* job = nullptr;
+    int jobCount = 0, jobGrain = 1;
+    std::atomic<int> nextChunk{ 0 };
+    int busy = 0;                   // participants still working on the job
+    unsigned generation = 0;
+    bool quit = false;
+
+    explicit ThreadPool(int threads) {
+        if (threads < 1) threads = 1;
+        for (int i = 1; i < threads; ++i) workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ~ThreadPool() {
+        { std::lock_guard<std::mutex> lock(mutex); quit = true; }
+        wake.notify_all();
+        for (std::thread& t : workers) t.join();
+    }
+
+    int size() const { return (int)workers.size() + 1; }
+
+    // Call fn(begin, end) for consecutive chunks of [0, count), each at least
+    // `grain` long, and return once all of them have finished
+    void parallelFor(int count, int grain, const std::function<void(int, int)>& fn) {
+        if (count <= 0) return;
+        if (grain < 1) grain = 1;
+        if (workers.empty() || count <= grain) { fn(0, count); return; }
+
+        std::lock_guard<std::mutex> serial(submit);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            jobCount = count;
+            jobGrain = grain;
+            nextChunk = 0;
+            busy = (int)workers.size() + 1;
+            generation++;
+        }
+        wake.notify_all();
+        runChunks(fn, count, grain);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        busy--;
+        done.wait(lock, [this] { return busy == 0; });
+        job = nullptr;
+    }
+
+    void runChunks(const std::function<void(int, int)>& fn, int count, int grain) {
+        for (;;) {
+            int begin = nextChunk.fetch_add(grain);
+            if (begin >= count) break;
+            fn(begin, begin + grain < count ? begin + grain : count);
+        }
+    }
+
+    void workerLoop() {
+        unsigned seen = 0;
+        for (;;) {
+            const std::function<void(int, int)>* fn;
+            int count, grain;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return quit || generation != seen; });
+                if (quit) return;
+                seen = generation;
+                fn = job; count = jobCount; grain = jobGrain;
+            }
+            runChunks(*fn, count, grain);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) done.notify_one();
+        }
+    }
+};
+
+// Number of hardware threads, at least 1
+inline int hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? (int)n : 1;
+}
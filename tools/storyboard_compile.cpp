@@ -0,0 +1,17 @@
+// storyboard_compile.cpp
+// Compile a text storyboard into the binary form the storyboard program maps.
+// The compiler and the source format are in storyboard_compile.h.
+//
+// Compile (Linux): g++ -O2 tools/storyboard_compile.cpp -o storyboard_compile
+// Usage: storyboard_compile SOURCE.txt OUT.sb
+
+#include "../storyboard_compile.h"
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: storyboard_compile SOURCE.txt OUT.sb\n");
+        return 2;
+    }
+    return storyboardCompile(argv[1], argv[2]) ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+// traffic.h
+// Smart City traffic: the simulation of traffic_sim.h drawn in place of the
+// storyboard's "traffic" hook. Two copies of the city run in step from the
+// same start, one under fixed-time signals and one under adaptive signals, so
+// both are measured all along. The scene shows the fixed-time city before it
+// is started and the adaptive one after ('s' enables smart control), with
+// the throughput and delay of both.
+//
+// Each story tick is TRAFFIC_TICK_SECONDS of traffic. The simulation is
+// stepped up to the tick being drawn; going back (reset, scrubbing, seeking)
+// replays it from the start.
+//
+// Options: --cars N (default 400), --traffic-threads N (default: one per hardware thread)
+#pragma once
+
+#include "render_batch.h"
+#include "text_atlas.h"
+#include "traffic_sim.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const float TRAFFIC_TICK_SECONDS = 0.25f;
+const float TRAFFIC_VIEW_Y = -0.1f, TRAFFIC_VIEW_HALF = 0.78f; // the city on screen, centred at x 0
+const float TRAFFIC_MIN_CAR_PIXELS = 2.0f; // cars of a big city are drawn at least this long
+const float TRAFFIC_AXIS_COLORS[2][3] = { { 0.15f, 0.3f, 0.9f }, { 0.9f, 0.2f, 0.15f } }; // east-west, north-south
+
+struct Traffic {
+    int cars = 400;             // --cars
+    int threads = 0;            // --traffic-threads, 0: one per hardware thread
+    TrafficNet nets[2];         // by SignalControl
+    ThreadPool* pool = nullptr;
+    // cars on screen, read by the instanced draws at flush
+    std::vector<float> x, y, scale, dirX, dirY;
+    BatchMesh meshes[2];        // by axis
+};
+
+inline bool trafficParseArg(int argc, char** argv, int& i, Traffic& t) {
+    if (strcmp(argv[i], "--cars") == 0 && i + 1 < argc) { t.cars = atoi(argv[++i]); return true; }
+    if (strcmp(argv[i], "--traffic-threads") == 0 && i + 1 < argc) { t.threads = atoi(argv[++i]); return true; }
+    return false;
+}
+
+// Build both cities and the car templates (call once GL is up)
+inline void trafficInit(Traffic& t) {
+    for (int c = 0; c < 2; ++c) trafficNetInit(t.nets[c], t.cars, c);
+    t.pool = new ThreadPool(t.threads > 0 ? t.threads : hardwareThreads());
+    size_t cars = t.nets[0].pos.size();
+    for (std::vector<float>* a : { &t.x, &t.y, &t.scale, &t.dirX, &t.dirY }) a->assign(cars, 0.0f);
+    // a car one unit long, pointing along +x
+    for (int axis = 0; axis < 2; ++axis) {
+        batchMeshBegin(t.meshes[axis]);
+        batchColor3f(TRAFFIC_AXIS_COLORS[axis][0], TRAFFIC_AXIS_COLORS[axis][1], TRAFFIC_AXIS_COLORS[axis][2]);
+        batchBegin(GL_QUADS);
+        batchVertex2f(-0.5f, -0.22f);
+        batchVertex2f(0.5f, -0.22f);
+        batchVertex2f(0.5f, 0.22f);
+        batchVertex2f(-0.5f, 0.22f);
+        batchEnd();
+        batchMeshEnd(t.meshes[axis]);
+    }
+}
+
+// Both cities at `step`, replayed from the start when it lies behind them
+inline void trafficAdvance(Traffic& t, int step) {
+    for (TrafficNet& n : t.nets) {
+        if (step < n.step) {
+            long long steps = n.steps;
+            double ms = n.ms;
+            trafficNetInit(n, t.cars, n.control);
+            n.steps = steps;
+            n.ms = ms;
+        }
+        while (n.step < step) trafficNetStep(n, *t.pool, TRAFFIC_TICK_SECONDS);
+    }
+}
+
+inline void trafficQuad(float x0, float y0, float x1, float y1) {
+    batchVertex2f(x0, y0);
+    batchVertex2f(x1, y0);
+    batchVertex2f(x1, y1);
+    batchVertex2f(x0, y1);
+}
+
+// The city at `tick`: streets, stop lines in their signal colors, cars as one
+// instanced draw per direction, and the measurements once started
+inline void trafficDraw(Traffic& t, bool running, float tick) {
+    trafficAdvance(t, running ? (int)tick : 0);
+    const TrafficNet& n = t.nets[running ? SIGNAL_ADAPTIVE : SIGNAL_FIXED];
+    float unit = 2.0f * TRAFFIC_VIEW_HALF / n.length; // screen units per metre
+    float ox = -TRAFFIC_VIEW_HALF, oy = TRAFFIC_VIEW_Y - TRAFFIC_VIEW_HALF;
+    const float half = TRAFFIC_LANES * TRAFFIC_LANE_WIDTH, B = TRAFFIC_BLOCK;
+
+    batchColor3f(0.3f, 0.3f, 0.3f);
+    batchBegin(GL_QUADS);
+    for (int r = 0; r < n.grid; ++r) {
+        float c = (r + 0.5f) * B;
+        trafficQuad(ox, oy + (c - half) * unit, ox + n.length * unit, oy + (c + half) * unit);
+        trafficQuad(ox + (c - half) * unit, oy, ox + (c + half) * unit, oy + n.length * unit);
+    }
+    batchEnd();
+
+    // stop lines, on the right-hand lanes of each approach
+    const float back = TRAFFIC_STOP_BACK, bar = 2.0f;
+    batchBegin(GL_QUADS);
+    for (int j = 0; j < trafficJunctions(n); ++j) {
+        float cx = (j % n.grid + 0.5f) * B, cy = (j / n.grid + 0.5f) * B;
+        for (int axis = 0; axis < 2; ++axis) {
+            if (n.green[j] == axis) batchColor3f(0.1f, 0.8f, 0.1f);
+            else batchColor3f(0.9f, 0.1f, 0.1f);
+            if (axis == AXIS_EW) {
+                trafficQuad(ox + (cx - back - bar) * unit, oy + (cy - half) * unit, ox + (cx - back) * unit, oy + cy * unit);
+                trafficQuad(ox + (cx + back) * unit, oy + cy * unit, ox + (cx + back + bar) * unit, oy + (cy + half) * unit);
+            }
+            else {
+                trafficQuad(ox + cx * unit, oy + (cy - back - bar) * unit, ox + (cx + half) * unit, oy + (cy - back) * unit);
+                trafficQuad(ox + (cx - half) * unit, oy + (cy + back) * unit, ox + cx * unit, oy + (cy + back + bar) * unit);
+            }
+        }
+    }
+    batchEnd();
+
+    // cars, lane by lane: lanes run along their street, right of its centre line
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    float scale = std::max(CAR_LENGTH * unit, TRAFFIC_MIN_CAR_PIXELS * 2.0f / std::max(1, viewport[3]));
+    int axisStart[3] = { 0, (int)n.pos.size(), (int)n.pos.size() };
+    for (const TrafficLane& lane : n.lanes) {
+        float sign = lane.reverse ? -1.0f : 1.0f;
+        float across = (lane.road + 0.5f) * B + (lane.axis == AXIS_EW ? -sign : sign) *
+            (lane.side + 0.5f) * TRAFFIC_LANE_WIDTH;
+        float start = lane.reverse ? n.length : 0.0f;
+        float* along = lane.axis == AXIS_EW ? &t.x[lane.first] : &t.y[lane.first];
+        float* side = lane.axis == AXIS_EW ? &t.y[lane.first] : &t.x[lane.first];
+        float alongOrigin = lane.axis == AXIS_EW ? ox : oy, sideAt = (lane.axis == AXIS_EW ? oy : ox) + across * unit;
+        for (int i = 0; i < lane.count; ++i) {
+            along[i] = alongOrigin + (start + sign * n.pos[lane.first + i]) * unit;
+            side[i] = sideAt;
+        }
+        std::fill(&t.scale[lane.first], &t.scale[lane.first] + lane.count, scale);
+        std::fill(&t.dirX[lane.first], &t.dirX[lane.first] + lane.count, lane.axis == AXIS_EW ? sign : 0.0f);
+        std::fill(&t.dirY[lane.first], &t.dirY[lane.first] + lane.count, lane.axis == AXIS_EW ? 0.0f : sign);
+        if (lane.axis == AXIS_NS) axisStart[1] = std::min(axisStart[1], lane.first);
+    }
+    for (int axis = 0; axis < 2; ++axis) {
+        int first = axisStart[axis], count = axisStart[axis + 1] - first;
+        if (count > 0)
+            batchDrawInstances(t.meshes[axis], &t.x[first], &t.y[first], &t.scale[first], &t.dirX[first],
+                &t.dirY[first], count, 1.0f, false);
+    }
+
+    if (!running || n.step == 0) return;
+    char line[160];
+    int seconds = (int)n.time;
+    snprintf(line, sizeof(line), "%d cars, %d junctions, %d:%02d of traffic", t.cars, trafficJunctions(n),
+        seconds / 60, seconds % 60);
+    textDraw(line, -0.95f, 0.83f, batchNextLayerZ(), 0, 0, 0);
+    static const char* const NAMES[2] = { "Fixed-time signals", "Adaptive signals" };
+    for (int c = 0; c < 2; ++c) {
+        snprintf(line, sizeof(line), "%s: %.0f cars/h per junction, %.1f s delay per junction", NAMES[c],
+            trafficThroughput(t.nets[c]), trafficDelay(t.nets[c]));
+        textDraw(line, -0.95f, 0.78f - 0.05f * c, batchNextLayerZ(), 0, 0, 0);
+    }
+}
+
+inline void trafficPrintStats(const Traffic& t) {
+    for (int c = 0; c < 2; ++c) {
+        const TrafficNet& n = t.nets[c];
+        if (n.steps == 0) continue;
+        double ms = n.ms / n.steps;
+        printf("traffic %s: %d cars, %zu lanes, %d junctions, %lld steps, %.3f ms/step (%.0f steps/s) on %d threads; "
+            "%.0f cars/h per junction, %.1f s delay per junction\n", c == SIGNAL_FIXED ? "fixed-time" : "adaptive",
+            t.cars, n.lanes.size(), trafficJunctions(n), n.steps, ms, ms > 0 ? 1000.0 / ms : 0.0, t.pool->size(),
+            trafficThroughput(n), trafficDelay(n));
+    }
+}
@@ -0,0 +1,321 @@
+// traffic_sim.h
+// Microscopic traffic on a grid of two-way streets with a signal at every
+// junction. Each car follows the one ahead by the Intelligent Driver Model
+// (IDM) and treats a red light it can still stop for as a standing car on the
+// stop line. Streets wrap around at the edges of the grid, so every lane is a
+// ring, cars keep their lane and the number of cars stays the same.
+//
+// Cars are structure-of-arrays (position, speed, acceleration, desired speed),
+// lane by lane, each lane sorted by position: the car ahead of car i is i + 1,
+// and the front car follows the back one a lap ahead. A step is one pass per
+// lane, lanes split over a ThreadPool, with the car following and the
+// integration done four cars at a time with SSE; the red lights touch one car
+// per stop line, found by binary search. The signals are updated after the
+// lanes, from the count of cars each stop line's detector saw.
+//
+// Two controls: fixed-time signals alternate the two directions every
+// SIGNAL_GREEN seconds; adaptive ones hold green while cars keep coming and
+// hand it over once the detectors on green are empty and someone waits at
+// red, within a minimum and a maximum green. Both count the cars
+// crossing stop lines (throughput) and the time lost against each car's
+// desired speed (delay). Units are metres and seconds. No GL here.
+#pragma once
+
+#include "thread_pool.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+// Intelligent Driver Model
+const float IDM_ACCEL = 1.5f;           // a: maximum acceleration, m/s^2
+const float IDM_BRAKE = 2.0f;           // b: comfortable deceleration
+const float IDM_HEADWAY = 1.2f;         // T: time gap to the car ahead, s
+const float IDM_MIN_GAP = 2.0f;         // s0: gap when standing
+const float IDM_SPEED = 13.9f;          // v0: 50 km/h, varied by +-10% per car
+const float CAR_LENGTH = 4.5f;
+const float TRAFFIC_MAX_BRAKE = 6.0f;   // a car that cannot stop for red at this goes through
+// Network
+const float TRAFFIC_BLOCK = 150.0f;     // junction spacing
+const int TRAFFIC_LANES = 2;            // per direction
+const float TRAFFIC_LANE_WIDTH = 3.5f;
+const float TRAFFIC_STOP_BACK = 9.0f;   // stop line to the junction centre
+const float TRAFFIC_DETECTOR = 60.0f;   // cars this far before a stop line are counted
+const float TRAFFIC_SPACING = 25.0f;    // lane length per car when sizing the grid
+const int TRAFFIC_GRAIN = 4;            // lanes per parallel chunk
+// Signals
+const float SIGNAL_GREEN = 30.0f;       // fixed-time green per direction
+const float SIGNAL_CLEARANCE = 3.0f;    // all red between greens
+const float SIGNAL_MIN_GREEN = 8.0f, SIGNAL_MAX_GREEN = 60.0f; // adaptive
+
+enum TrafficAxis { AXIS_EW, AXIS_NS, AXIS_NONE }; // AXIS_NONE: all red
+enum SignalControl { SIGNAL_FIXED, SIGNAL_ADAPTIVE };
+
+struct TrafficLane {
+    int first, count;           // cars, sorted by position
+    int axis;                   // AXIS_EW or AXIS_NS
+    int road;                   // row (east-west) or column (north-south)
+    int side;                   // 0 .. TRAFFIC_LANES - 1, from the centre line out
+    bool reverse;               // westbound or southbound: position runs against the axis
+    // written by the thread stepping the lane
+    long long crossings;        // cars over a stop line
+    double delay;               // s
+};
+
+struct TrafficNet {
+    int control = SIGNAL_FIXED;
+    int grid = 0;               // streets each way, and junctions per lane
+    float length = 0;           // of every lane
+    std::vector<TrafficLane> lanes;
+    std::vector<float> pos, vel, acc, desired; // cars, lane by lane
+    // junctions, row by row
+    std::vector<unsigned char> green, nextGreen; // TrafficAxis
+    std::vector<float> phaseTime;
+    std::vector<int> demand;    // per lane and stop line: cars on the detector
+    std::vector<int> waiting;   // per junction and axis
+    int step = 0;
+    float time = 0;
+    long long crossings = 0;
+    double delay = 0;
+    // statistics
+    long long steps = 0;
+    double ms = 0;
+};
+
+inline int trafficJunctions(const TrafficNet& n) { return n.grid * n.grid; }
+
+// Junction at the k-th stop line of lane l
+inline int trafficJunction(const TrafficNet& n, const TrafficLane& l, int k) {
+    int along = l.reverse ? n.grid - 1 - k : k;
+    return l.axis == AXIS_EW ? l.road * n.grid + along : along * n.grid + l.road;
+}
+
+// Stop line k, as a position along any lane
+inline float trafficStopLine(int k) {
+    return (k + 0.5f) * TRAFFIC_BLOCK - TRAFFIC_STOP_BACK;
+}
+
+// Streets enough to give each of `cars` about TRAFFIC_SPACING of lane, cars
+// spread evenly over the lanes with a little jitter, all standing, all signals
+// starting green east-west. The same seed gives the same city.
+inline void trafficNetInit(TrafficNet& n, int cars, int control, unsigned seed = 2024) {
+    n = TrafficNet();
+    n.control = control;
+    if (cars < 0) cars = 0;
+    float laneMetresPerGrid2 = 4.0f * TRAFFIC_LANES * TRAFFIC_BLOCK; // 2 axes x 2 directions
+    n.grid = std::max(1, (int)ceilf(sqrtf(cars * TRAFFIC_SPACING / laneMetresPerGrid2)));
+    n.length = n.grid * TRAFFIC_BLOCK;
+    auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+
+    for (int axis = 0; axis < 2; ++axis)
+        for (int road = 0; road < n.grid; ++road)
+            for (int dir = 0; dir < 2; ++dir)
+                for (int side = 0; side < TRAFFIC_LANES; ++side)
+                    n.lanes.push_back({ 0, 0, axis, road, side, dir == 1, 0, 0.0 });
+    int laneCount = (int)n.lanes.size();
+    for (int l = 0; l < laneCount; ++l) {
+        TrafficLane& lane = n.lanes[l];
+        lane.first = (int)n.pos.size();
+        lane.count = cars / laneCount + (l < cars % laneCount ? 1 : 0);
+        float spacing = n.length / std::max(1, lane.count);
+        for (int i = 0; i < lane.count; ++i) {
+            n.pos.push_back((i + 0.5f * random()) * spacing);
+            n.vel.push_back(0.0f);
+            n.desired.push_back(IDM_SPEED * (0.9f + 0.2f * random()));
+        }
+    }
+    n.acc.assign(n.pos.size(), 0.0f);
+    n.green.assign(trafficJunctions(n), AXIS_EW);
+    n.nextGreen.assign(trafficJunctions(n), AXIS_NS);
+    n.phaseTime.assign(trafficJunctions(n), 0.0f);
+    n.demand.assign(n.lanes.size() * n.grid, 0);
+    n.waiting.assign(trafficJunctions(n) * 2, 0);
+}
+
+// ---------------- Car following ----------------
+inline float idmAccel(float v, float v0, float gap, float dv) {
+    float sStar = IDM_MIN_GAP + std::max(0.0f, v * IDM_HEADWAY + v * dv / (2.0f * sqrtf(IDM_ACCEL * IDM_BRAKE)));
+    float r = v / v0, s = sStar / std::max(gap, 0.1f);
+    return IDM_ACCEL * (1.0f - r * r * r * r - s * s);
+}
+
+inline __m128 idmAccel4(__m128 v, __m128 v0, __m128 gap, __m128 dv) {
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    __m128 sStar = _mm_mul_ps(v, _mm_add_ps(_mm_set1_ps(IDM_HEADWAY),
+        _mm_mul_ps(dv, _mm_set1_ps(0.5f / sqrtf(IDM_ACCEL * IDM_BRAKE)))));
+    sStar = _mm_add_ps(_mm_set1_ps(IDM_MIN_GAP), _mm_max_ps(zero, sStar));
+    __m128 r = _mm_div_ps(v, v0);
+    r = _mm_mul_ps(r, r);
+    __m128 s = _mm_div_ps(sStar, _mm_max_ps(gap, _mm_set1_ps(0.1f)));
+    __m128 brake = _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(s, s));
+    return _mm_mul_ps(_mm_set1_ps(IDM_ACCEL), _mm_sub_ps(one, brake));
+}
+
+// Ballistic step of one car: new speed, distance (a car braking to a stop
+// within the step stops where it would), never past `limit`
+inline void trafficMove(float& x, float& v, float a, float limit, float dt) {
+    float vn = v + a * dt, dx;
+    if (vn < 0.0f) { dx = -v * v / (2.0f * a); vn = 0.0f; }
+    else dx = 0.5f * (v + vn) * dt;
+    x = std::max(x, std::min(x + dx, limit));
+    v = vn;
+}
+
+// Stop lines passed between positions x0 and x1 (x1 >= x0, up to a lap on)
+inline int trafficLinesCrossed(float x0, float x1) {
+    const float off = TRAFFIC_BLOCK - trafficStopLine(0); // keeps both positive
+    return (int)((x1 + off) / TRAFFIC_BLOCK) - (int)((x0 + off) / TRAFFIC_BLOCK);
+}
+
+// One step of lane l: follow, stop for red, move, and wrap the cars that
+// finished a lap round to the back
+inline void trafficStepLane(TrafficNet& n, int l, float dt) {
+    TrafficLane& lane = n.lanes[l];
+    int count = lane.count;
+    int* demand = &n.demand[(size_t)l * n.grid];
+    if (count == 0) { std::fill(demand, demand + n.grid, 0); return; }
+    float* x = &n.pos[lane.first];
+    float* v = &n.vel[lane.first];
+    float* a = &n.acc[lane.first];
+    const float* v0 = &n.desired[lane.first];
+    const float L = n.length;
+
+    // car following: car i behind car i + 1, the front car behind the back one a lap on
+    const __m128 len = _mm_set1_ps(CAR_LENGTH);
+    int i = 0;
+    for (; i + 4 < count; i += 4) {
+        __m128 xi = _mm_loadu_ps(x + i), vi = _mm_loadu_ps(v + i);
+        __m128 gap = _mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(x + i + 1), xi), len);
+        __m128 dv = _mm_sub_ps(vi, _mm_loadu_ps(v + i + 1));
+        _mm_storeu_ps(a + i, idmAccel4(vi, _mm_loadu_ps(v0 + i), gap, dv));
+    }
+    for (; i < count - 1; ++i) a[i] = idmAccel(v[i], v0[i], x[i + 1] - x[i] - CAR_LENGTH, v[i] - v[i + 1]);
+    a[count - 1] = idmAccel(v[count - 1], v0[count - 1], x[0] + L - x[count - 1] - CAR_LENGTH, v[count - 1] - v[0]);
+
+    // stop lines: count the detector, and hold the first car before a red one
+    for (int k = 0; k < n.grid; ++k) {
+        float line = trafficStopLine(k);
+        int behind = (int)(std::upper_bound(x, x + count, line) - x);
+        int from = (int)(std::lower_bound(x, x + count, line - TRAFFIC_DETECTOR) - x);
+        demand[k] = behind - from;
+        if (n.green[trafficJunction(n, lane, k)] == lane.axis) continue;
+        int c = behind > 0 ? behind - 1 : count - 1;
+        float gap = line - x[c];
+        if (gap < 0.0f) gap += L;
+        if (v[c] * v[c] > 2.0f * TRAFFIC_MAX_BRAKE * gap) continue; // too close: goes through
+        a[c] = std::min(a[c], idmAccel(v[c], v0[c], gap, v[c]));
+    }
+
+    // move; nobody passes the car ahead's old position, and the front car is
+    // moved last as its leader's old position is x[0]
+    float lastX = x[count - 1], lastV = v[count - 1];
+    trafficMove(lastX, lastV, a[count - 1], x[0] + L - 0.1f, dt);
+    long long crossed = trafficLinesCrossed(x[count - 1], lastX);
+    float lost = dt * std::max(0.0f, 1.0f - lastV / v0[count - 1]);
+
+    const __m128 zero = _mm_setzero_ps(), half = _mm_set1_ps(0.5f), step = _mm_set1_ps(dt);
+    const __m128 off = _mm_set1_ps(TRAFFIC_BLOCK - trafficStopLine(0)), block = _mm_set1_ps(1.0f / TRAFFIC_BLOCK);
+    __m128i crossed4 = _mm_setzero_si128();
+    __m128 lost4 = zero;
+    i = 0;
+    for (; i + 4 < count; i += 4) {
+        __m128 xi = _mm_loadu_ps(x + i), vi = _mm_loadu_ps(v + i), ai = _mm_loadu_ps(a + i);
+        __m128 vn = _mm_add_ps(vi, _mm_mul_ps(ai, step));
+        __m128 stopped = _mm_cmplt_ps(vn, zero);
+        __m128 dx = _mm_mul_ps(_mm_mul_ps(half, _mm_add_ps(vi, vn)), step);
+        __m128 dxStop = _mm_div_ps(_mm_mul_ps(vi, vi), _mm_mul_ps(_mm_set1_ps(-2.0f), ai));
+        dx = _mm_or_ps(_mm_and_ps(stopped, dxStop), _mm_andnot_ps(stopped, dx));
+        vn = _mm_max_ps(zero, vn);
+        __m128 limit = _mm_sub_ps(_mm_loadu_ps(x + i + 1), _mm_set1_ps(0.1f));
+        __m128 xn = _mm_max_ps(xi, _mm_min_ps(_mm_add_ps(xi, dx), limit));
+        crossed4 = _mm_add_epi32(crossed4, _mm_sub_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(xn, off), block)),
+            _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(xi, off), block))));
+        __m128 slow = _mm_max_ps(zero, _mm_sub_ps(_mm_set1_ps(1.0f), _mm_div_ps(vn, _mm_loadu_ps(v0 + i))));
+        lost4 = _mm_add_ps(lost4, _mm_mul_ps(step, slow));
+        _mm_storeu_ps(x + i, xn);
+        _mm_storeu_ps(v + i, vn);
+    }
+    for (; i < count - 1; ++i) {
+        float x0 = x[i];
+        trafficMove(x[i], v[i], a[i], x[i + 1] - 0.1f, dt);
+        crossed += trafficLinesCrossed(x0, x[i]);
+        lost += dt * std::max(0.0f, 1.0f - v[i] / v0[i]);
+    }
+    x[count - 1] = lastX;
+    v[count - 1] = lastV;
+    int c4[4];
+    float l4[4];
+    _mm_storeu_si128((__m128i*)c4, crossed4);
+    _mm_storeu_ps(l4, lost4);
+    lane.crossings += crossed + c4[0] + c4[1] + c4[2] + c4[3];
+    lane.delay += lost + l4[0] + l4[1] + l4[2] + l4[3];
+
+    // cars past the end start the next lap at the back, keeping the lane sorted
+    int wrapped = 0;
+    while (wrapped < count && x[count - 1 - wrapped] >= L) x[count - 1 - wrapped++] -= L;
+    if (wrapped > 0) {
+        float* desired = &n.desired[lane.first];
+        std::rotate(x, x + count - wrapped, x + count);
+        std::rotate(v, v + count - wrapped, v + count);
+        std::rotate(desired, desired + count - wrapped, desired + count);
+    }
+}
+
+// ---------------- Signals ----------------
+inline void trafficStepSignals(TrafficNet& n, float dt) {
+    std::fill(n.waiting.begin(), n.waiting.end(), 0);
+    for (size_t l = 0; l < n.lanes.size(); ++l)
+        for (int k = 0; k < n.grid; ++k)
+            n.waiting[trafficJunction(n, n.lanes[l], k) * 2 + n.lanes[l].axis] += n.demand[l * n.grid + k];
+    for (int j = 0; j < trafficJunctions(n); ++j) {
+        float t = n.phaseTime[j] += dt;
+        int g = n.green[j];
+        if (g == AXIS_NONE) {
+            if (t >= SIGNAL_CLEARANCE) { n.green[j] = n.nextGreen[j]; n.phaseTime[j] = 0.0f; }
+            continue;
+        }
+        bool change;
+        if (n.control == SIGNAL_FIXED) change = t >= SIGNAL_GREEN;
+        else {
+            // gap out: nobody left coming on green, someone waiting at red
+            int red = n.waiting[j * 2 + 1 - g], coming = n.waiting[j * 2 + g];
+            change = t >= SIGNAL_MIN_GREEN && red > 0 && (coming == 0 || t >= SIGNAL_MAX_GREEN);
+        }
+        if (change) {
+            n.nextGreen[j] = (unsigned char)(1 - g);
+            n.green[j] = AXIS_NONE;
+            n.phaseTime[j] = 0.0f;
+        }
+    }
+}
+
+// Advance the whole network by dt seconds
+inline void trafficNetStep(TrafficNet& n, ThreadPool& pool, float dt) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    pool.parallelFor((int)n.lanes.size(), TRAFFIC_GRAIN, [&](int begin, int end) {
+        for (int l = begin; l < end; ++l) trafficStepLane(n, l, dt);
+    });
+    trafficStepSignals(n, dt);
+    n.crossings = 0;
+    n.delay = 0;
+    for (const TrafficLane& lane : n.lanes) {
+        n.crossings += lane.crossings;
+        n.delay += lane.delay;
+    }
+    n.step++;
+    n.time += dt;
+    n.steps++;
+    n.ms += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Cars through a junction per hour, per junction, since the start
+inline double trafficThroughput(const TrafficNet& n) {
+    return n.time > 0 ? n.crossings / (n.time / 3600.0) / trafficJunctions(n) : 0.0;
+}
+
+// Seconds lost per junction passed
+inline double trafficDelay(const TrafficNet& n) {
+    return n.crossings > 0 ? n.delay / n.crossings : 0.0;
+}
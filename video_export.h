@@ -0,0 +1,227 @@
+// video_export.h
+// Video export for headless runs. Each rendered frame is read back into one of
+// a fixed pool of buffers and queued; a writer thread converts the queued
+// frames and streams them to a file or a pipe, so rendering only waits when the
+// queue is full (the disk or the encoder on the other end is slower than the
+// renderer) and never on a write itself.
+//
+// Options: --video FILE [--video-format y4m|rgb] [--video-queue N] [--fps N]
+// FILE may be "|command" to pipe into an encoder, e.g.
+//   --video "|ffmpeg -y -i - story.mp4"
+// y4m (the default, and what FILE.y4m implies) is YUV 4:2:0 with a header any
+// player or encoder reads; rgb is bare top-down RGB24 frames, e.g. for
+//   ffmpeg -f rawvideo -pix_fmt rgb24 -s 1920x1080 -r 30 -i - out.mp4
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum VideoFormat { VIDEO_Y4M, VIDEO_RGB };
+
+// Queue entry meaning "the previous frame again" (an unchanged frame)
+const int VIDEO_REPEAT = -1;
+
+struct VideoExport {
+    const char* path = nullptr; // --video
+    VideoFormat format = VIDEO_Y4M;
+    bool formatSet = false;
+    int queueDepth = 8;         // frames read back but not yet written
+    int fps = 30;
+    int width = 0, height = 0;
+    FILE* out = nullptr;
+    bool pipe = false;
+    std::vector<std::vector<unsigned char>> buffers; // bottom-up RGBA, as glReadPixels leaves it
+    std::deque<int> queued, unused; // buffer indices (VIDEO_REPEAT in queued)
+    std::mutex mutex;
+    std::condition_variable hasQueued, hasUnused;
+    bool closing = false;
+    std::thread writer;
+    // statistics
+    long long frames = 0, bytes = 0, waits = 0; // waits: frames the renderer found the queue full
+    double waitMs = 0, writeMs = 0;
+    std::chrono::steady_clock::time_point opened;
+    bool failed = false;        // a write failed (disk full, the pipe closed)
+};
+
+inline VideoExport video;
+
+// Parse one video option at argv[i], as headlessParseArg() does
+inline bool videoParseArg(int argc, char** argv, int& i) {
+    const char* a = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (strcmp(a, "--video") == 0 && hasValue) { video.path = argv[++i]; return true; }
+    if (strcmp(a, "--video-queue") == 0 && hasValue) { video.queueDepth = atoi(argv[++i]); return true; }
+    if (strcmp(a, "--fps") == 0 && hasValue) { video.fps = atoi(argv[++i]); return true; }
+    if (strcmp(a, "--video-format") == 0 && hasValue) {
+        const char* f = argv[++i];
+        if (strcmp(f, "y4m") == 0) video.format = VIDEO_Y4M;
+        else if (strcmp(f, "rgb") == 0) video.format = VIDEO_RGB;
+        else {
+            fprintf(stderr, "--video-format expects y4m or rgb\n");
+            exit(1);
+        }
+        video.formatSet = true;
+        return true;
+    }
+    return false;
+}
+
+// ---------------- Conversion (writer thread) ----------------
+// BT.601 studio range, chroma averaged over 2x2 pixels; rows flipped to top-down
+inline void videoToY4m(const unsigned char* rgba, int w, int h, std::vector<unsigned char>& yuv) {
+    int cw = (w + 1) / 2, ch = (h + 1) / 2;
+    yuv.resize((size_t)w * h + 2 * (size_t)cw * ch);
+    unsigned char* Y = yuv.data();
+    unsigned char* U = Y + (size_t)w * h;
+    unsigned char* V = U + (size_t)cw * ch;
+    for (int y = 0; y < h; ++y) {
+        const unsigned char* p = rgba + (size_t)(h - 1 - y) * w * 4;
+        unsigned char* row = Y + (size_t)y * w;
+        for (int x = 0; x < w; ++x, p += 4)
+            row[x] = (unsigned char)(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+    }
+    for (int cy = 0; cy < ch; ++cy) {
+        int y0 = 2 * cy, y1 = y0 + 1 < h ? y0 + 1 : y0;
+        const unsigned char* r0 = rgba + (size_t)(h - 1 - y0) * w * 4;
+        const unsigned char* r1 = rgba + (size_t)(h - 1 - y1) * w * 4;
+        for (int cx = 0; cx < cw; ++cx) {
+            int x0 = 2 * cx * 4, x1 = (2 * cx + 1 < w ? 2 * cx + 1 : 2 * cx) * 4;
+            int r = r0[x0] + r0[x1] + r1[x0] + r1[x1];
+            int g = r0[x0 + 1] + r0[x1 + 1] + r1[x0 + 1] + r1[x1 + 1];
+            int b = r0[x0 + 2] + r0[x1 + 2] + r1[x0 + 2] + r1[x1 + 2];
+            U[(size_t)cy * cw + cx] = (unsigned char)(((-38 * r - 74 * g + 112 * b + 512) >> 10) + 128);
+            V[(size_t)cy * cw + cx] = (unsigned char)(((112 * r - 94 * g - 18 * b + 512) >> 10) + 128);
+        }
+    }
+}
+
+inline void videoToRgb(const unsigned char* rgba, int w, int h, std::vector<unsigned char>& out) {
+    out.resize((size_t)w * h * 3);
+    unsigned char* o = out.data();
+    for (int y = 0; y < h; ++y) {
+        const unsigned char* p = rgba + (size_t)(h - 1 - y) * w * 4;
+        for (int x = 0; x < w; ++x, p += 4, o += 3) {
+            o[0] = p[0];
+            o[1] = p[1];
+            o[2] = p[2];
+        }
+    }
+}
+
+inline void videoWriterLoop() {
+    VideoExport& v = video;
+    std::vector<unsigned char> frame; // converted; kept for repeats
+    for (;;) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(v.mutex);
+            v.hasQueued.wait(lock, [&] { return !v.queued.empty() || v.closing; });
+            if (v.queued.empty()) return; // closing and drained
+            index = v.queued.front();
+            v.queued.pop_front();
+        }
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        if (index != VIDEO_REPEAT) {
+            if (v.format == VIDEO_Y4M) videoToY4m(v.buffers[index].data(), v.width, v.height, frame);
+            else videoToRgb(v.buffers[index].data(), v.width, v.height, frame);
+            {
+                std::lock_guard<std::mutex> lock(v.mutex);
+                v.unused.push_back(index);
+            }
+            v.hasUnused.notify_one();
+        }
+        if (!v.failed) {
+            if (v.format == VIDEO_Y4M) fputs("FRAME\n", v.out);
+            if (fwrite(frame.data(), 1, frame.size(), v.out) != frame.size()) {
+                fprintf(stderr, "video: write to %s failed\n", v.path);
+                v.failed = true;
+            }
+            v.bytes += (long long)frame.size() + (v.format == VIDEO_Y4M ? 6 : 0);
+        }
+        v.frames++;
+        v.writeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+}
+
+// ---------------- Renderer side ----------------
+// Open the output and start the writer for w x h frames
+inline bool videoOpen(int w, int h) {
+    VideoExport& v = video;
+    const char* ext = strrchr(v.path, '.');
+    if (!v.formatSet) v.format = ext && strcmp(ext, ".rgb") == 0 ? VIDEO_RGB : VIDEO_Y4M;
+    if (v.queueDepth < 1) v.queueDepth = 1;
+    if (v.fps < 1) v.fps = 30;
+    v.pipe = v.path[0] == '|';
+    v.out = v.pipe ? popen(v.path + 1, "w") : fopen(v.path, "wb");
+    if (!v.out) {
+        fprintf(stderr, "video: cannot open %s\n", v.path);
+        return false;
+    }
+    setvbuf(v.out, nullptr, _IOFBF, 1 << 20);
+    if (v.format == VIDEO_Y4M) fprintf(v.out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", w, h, v.fps);
+    v.width = w;
+    v.height = h;
+    v.buffers.assign(v.queueDepth, std::vector<unsigned char>((size_t)w * h * 4));
+    v.queued.clear();
+    v.unused.clear();
+    for (int i = 0; i < v.queueDepth; ++i) v.unused.push_back(i);
+    v.closing = false;
+    v.opened = std::chrono::steady_clock::now();
+    v.writer = std::thread(videoWriterLoop);
+    return true;
+}
+
+// A free buffer to read the next frame into (w * h RGBA pixels, bottom-up as
+// glReadPixels writes them); waits while every buffer is queued. Hand it back
+// with videoSubmit().
+inline int videoAcquire(unsigned char** pixels) {
+    VideoExport& v = video;
+    std::unique_lock<std::mutex> lock(v.mutex);
+    if (v.unused.empty()) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        v.waits++;
+        v.hasUnused.wait(lock, [&] { return !v.unused.empty(); });
+        v.waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+    int index = v.unused.front();
+    v.unused.pop_front();
+    *pixels = v.buffers[index].data();
+    return index;
+}
+
+// Queue a filled buffer, or VIDEO_REPEAT for the same picture as the last frame
+inline void videoSubmit(int index) {
+    {
+        std::lock_guard<std::mutex> lock(video.mutex);
+        video.queued.push_back(index);
+    }
+    video.hasQueued.notify_one();
+}
+
+// Write what is queued, close the output and report throughput
+inline void videoClose() {
+    VideoExport& v = video;
+    if (!v.out) return;
+    {
+        std::lock_guard<std::mutex> lock(v.mutex);
+        v.closing = true;
+    }
+    v.hasQueued.notify_one();
+    v.writer.join();
+    int status = v.pipe ? pclose(v.out) : fclose(v.out);
+    v.out = nullptr;
+    if (status != 0 && !v.failed) fprintf(stderr, "video: closing %s failed\n", v.path);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - v.opened).count();
+    printf("video: %lld frames (%dx%d %s) in %.1f ms (%.1f frames/sec, %.1fx real time at %d fps), %.1f MB to %s\n",
+        v.frames, v.width, v.height, v.format == VIDEO_Y4M ? "y4m" : "rgb", ms, v.frames * 1000.0 / (ms > 0 ? ms : 1),
+        v.frames * 1000.0 / v.fps / (ms > 0 ? ms : 1), v.fps, v.bytes / 1048576.0, v.path);
+    printf("video: writer busy %.1f ms; renderer waited for a free buffer %lld times (%.1f ms, queue of %d)\n",
+        v.writeMs, v.waits, v.waitMs, v.queueDepth);
+}
@@ -0,0 +1,140 @@
+// windfarm.h
+// Wind farm for Renewable Energy, the storyboard's "windfarm" hook: towers
+// with three-bladed rotors turning, each at its own speed and phase. The
+// default three turbines stand and turn as the scene always had them; a big
+// farm (--turbines N) fills the ground below the sky in rows, far rows small.
+//
+// Each turbine is a tower and a rotor placed by 2D transforms kept in flat
+// arrays (BatchTransforms): the towers' are fixed, the rotors' rewritten every
+// frame from the blade angles. batchDrawTransformed() then places the two
+// templates for a whole row at a time into the frame batch, with no matrix
+// stack and no per-turbine draw calls. Rows go back to front, so near
+// turbines cover far ones.
+//
+// Options: --turbines N (default 3)
+#pragma once
+
+#include "render_batch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const float WINDFARM_HUB_Y = 0.4f, WINDFARM_TOWER = 0.5f; // the story's turbines: hub height, tower length
+const float WINDFARM_SPEED = 3.0f;                          // degrees per tick
+const float WINDFARM_GROUND_TOP = 0.05f, WINDFARM_GROUND_BOTTOM = -0.95f; // tower feet of a big farm
+
+struct WindFarm {
+    int turbines = 3;           // --turbines
+    std::vector<float> phase, speed; // blade angle at tick 0 and its turn per tick, degrees
+    BatchTransforms towers, rotors;
+    std::vector<int> rowStart;  // rows back to front, and the end
+    BatchMesh towerMesh, rotorMesh;
+    // statistics
+    long long updates = 0;
+    double updateMs = 0;
+    int vertices = 0;           // last frame
+};
+
+inline bool windFarmParseArg(int argc, char** argv, int& i, WindFarm& f) {
+    if (strcmp(argv[i], "--turbines") == 0 && i + 1 < argc) { f.turbines = atoi(argv[++i]); return true; }
+    return false;
+}
+
+inline void windFarmPlace(WindFarm& f, int i, float x, float hubY, float scale, float phase, float speed) {
+    BatchTransforms& t = f.towers;
+    t.a[i] = scale; t.b[i] = 0.0f; t.c[i] = 0.0f; t.d[i] = scale;
+    t.tx[i] = x; t.ty[i] = hubY;
+    f.rotors.tx[i] = x;
+    f.rotors.ty[i] = hubY;
+    f.phase[i] = phase;
+    f.speed[i] = speed;
+}
+
+// Lay the farm out and record the templates (call once GL is up)
+inline void windFarmInit(WindFarm& f) {
+    int n = std::max(0, f.turbines);
+    batchTransformsResize(f.towers, n);
+    batchTransformsResize(f.rotors, n);
+    f.phase.assign(n, 0.0f);
+    f.speed.assign(n, 0.0f);
+    f.rowStart.assign(1, 0);
+    if (n <= 3) {
+        // the story's own row
+        for (int i = 0; i < n; ++i) windFarmPlace(f, i, 0.2f + 0.25f * i, WINDFARM_HUB_Y, 1.0f, 30.0f * i, WINDFARM_SPEED);
+        f.rowStart.push_back(n);
+    }
+    else {
+        // rows from the skyline down to the front, growing from half size to
+        // full, spaced by turbine size
+        unsigned seed = 2468; // the same farm every run
+        auto random = [&seed]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+        float depth = WINDFARM_GROUND_TOP - WINDFARM_GROUND_BOTTOM;
+        float scale = std::min(1.0f, sqrtf(8.0f * depth / n) / 0.35f); // about n turbines in all
+        int i = 0;
+        for (float feet = WINDFARM_GROUND_TOP; i < n && feet > WINDFARM_GROUND_BOTTOM; ) {
+            float s = scale * (0.5f + 0.5f * (WINDFARM_GROUND_TOP - feet) / depth); // far rows at half size
+            float step = 0.35f * s;
+            int columns = std::max(1, (int)(2.0f / step));
+            for (int c = 0; c < columns && i < n; ++c, ++i) {
+                float x = -1.0f + (c + 0.5f + 0.4f * (random() - 0.5f)) * 2.0f / columns;
+                windFarmPlace(f, i, x, feet + WINDFARM_TOWER * s, s, 360.0f * random(),
+                    WINDFARM_SPEED * (0.6f + 0.8f * random()));
+            }
+            f.rowStart.push_back(i);
+            feet -= 0.5f * step;
+        }
+        f.turbines = i; // as many as the ground holds
+        f.towers.count = f.rotors.count = i;
+    }
+
+    // tower from the hub down, rotor round the hub
+    batchMeshBegin(f.towerMesh);
+    batchColor3f(0.9f, 0.9f, 0.9f);
+    batchBegin(GL_LINES);
+    batchVertex2f(0.0f, 0.0f);
+    batchVertex2f(0.0f, -WINDFARM_TOWER);
+    batchEnd();
+    batchMeshEnd(f.towerMesh);
+    batchMeshBegin(f.rotorMesh);
+    batchColor3f(0.95f, 0.95f, 0.95f);
+    batchBegin(GL_TRIANGLES);
+    const float blades[] = { 0, 0, 0.15f, 0.03f, 0.05f, 0.06f, 0, 0, -0.15f, 0.03f, -0.05f, 0.06f,
+        0, 0, 0, -0.15f, 0.06f, -0.05f };
+    for (int v = 0; v < 18; v += 2) batchVertex2f(blades[v], blades[v + 1]);
+    batchEnd();
+    batchMeshEnd(f.rotorMesh);
+}
+
+// The farm at `tick`: every rotor's transform from its blade angle, then each
+// row's towers and rotors as two transformed draws
+inline void windFarmDraw(WindFarm& f, float tick) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    const float degrees = 3.14159265f / 180.0f;
+    BatchTransforms& r = f.rotors;
+    for (int i = 0; i < f.turbines; ++i) {
+        float angle = (f.phase[i] + f.speed[i] * tick) * degrees, s = f.towers.a[i];
+        float cs = s * cosf(angle), sn = s * sinf(angle);
+        r.a[i] = cs; r.b[i] = sn;
+        r.c[i] = -sn; r.d[i] = cs;
+    }
+    size_t before = batch.tris.size() + batch.lines.size();
+    for (size_t row = 0; row + 1 < f.rowStart.size(); ++row) {
+        int first = f.rowStart[row], count = f.rowStart[row + 1] - first;
+        batchDrawTransformed(f.towerMesh, f.towers, first, count);
+        batchDrawTransformed(f.rotorMesh, f.rotors, first, count);
+    }
+    f.vertices = (int)(batch.tris.size() + batch.lines.size() - before);
+    f.updates++;
+    f.updateMs += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+inline void windFarmPrintStats(const WindFarm& f) {
+    if (f.updates == 0) return;
+    printf("windfarm: %d turbines in %zu rows, %.3f ms/update; last frame %d vertices\n", f.turbines,
+        f.rowStart.size() - 1, f.updateMs / f.updates, f.vertices);
+}